@@ -0,0 +1,172 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include "tabulate.h"
+using namespace tabulate;
+
+// every allocation of the process goes through here
+static std::atomic<size_t> allocations(0), allocated_bytes(0);
+
+void *operator new(size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  RenderStats::count_allocation(size);
+  if (void *ptr = malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+  free(ptr);
+}
+
+struct Measure {
+  std::string name;
+  double allocations; // per unit
+  double bytes;       // per unit
+};
+
+template <typename Function>
+Measure measure(const std::string &name, size_t units, Function function)
+{
+  size_t count = allocations.load(), bytes = allocated_bytes.load();
+  function();
+  count = allocations.load() - count;
+  bytes = allocated_bytes.load() - bytes;
+  return {name, static_cast<double>(count) / units, static_cast<double>(bytes) / units};
+}
+
+// fixed content: no clocks, no randomness
+void fill(Table &table, size_t rows, size_t columns)
+{
+  std::vector<std::string> header;
+  for (size_t j = 0; j < columns; j++) {
+    header.push_back("Column " + std::to_string(j));
+  }
+  table.add_multiple(header);
+  for (size_t i = 0; i < rows; i++) {
+    std::vector<std::string> values;
+    for (size_t j = 0; j < columns; j++) {
+      values.push_back(std::to_string((i * 7919 + j * 104729) % 100000));
+    }
+    table.add_multiple(values);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const size_t ROWS = 200, COLUMNS = 8, CELLS = (ROWS + 1) * COLUMNS;
+  std::vector<Measure> measures;
+
+  // a warm-up table fills the per-thread render caches, the measures are steady state
+  {
+    Table warmup;
+    fill(warmup, ROWS, COLUMNS);
+    warmup[0].format().color(Color::yellow).styles(Style::bold);
+    warmup.xterm(ColorMode::truecolor);
+    warmup.markdown();
+    warmup.latex();
+  }
+
+  Table table;
+  measures.push_back(measure("add (per row)", ROWS + 1, [&]() { fill(table, ROWS, COLUMNS); }));
+  table[0].format().color(Color::yellow).styles(Style::bold);
+
+  std::string exported;
+  measures.push_back(measure("xterm (per cell)", CELLS, [&]() { exported = table.xterm(ColorMode::truecolor); }));
+  measures.push_back(measure("xterm plain (per cell)", CELLS, [&]() { exported = table.xterm(ColorMode::none); }));
+  measures.push_back(measure("markdown (per cell)", CELLS, [&]() { exported = table.markdown(); }));
+  measures.push_back(measure("latex (per cell)", CELLS, [&]() { exported = table.latex(); }));
+
+  // baseline file: one "name<TAB>allocations<TAB>bytes" line per measure
+  const double TOLERANCE = 0.10;
+  std::map<std::string, std::pair<double, double>> baseline;
+  bool update = argc > 2 && std::string(argv[2]) == "--update";
+  if (argc > 1 && !update) {
+    std::ifstream in(argv[1]);
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      size_t tab = line.find('\t'), next = line.find('\t', tab + 1);
+      if (tab != std::string::npos && next != std::string::npos) {
+        baseline[line.substr(0, tab)] = {atof(line.substr(tab + 1, next - tab - 1).c_str()), atof(line.substr(next + 1).c_str())};
+      }
+    }
+  }
+
+  bool regressed = false;
+  Table report;
+  report.add("Measure", "Allocations", "Bytes", "Baseline Allocations", "Baseline Bytes", "Status");
+  report[0].format().styles(Style::bold);
+  for (auto const &m : measures) {
+    auto it = baseline.find(m.name);
+    std::string status = "no baseline";
+    std::string base_allocations = "-", base_bytes = "-";
+    if (it != baseline.end()) {
+      bool worse = m.allocations > it->second.first * (1 + TOLERANCE) + 0.01 || m.bytes > it->second.second * (1 + TOLERANCE) + 1;
+      status = worse ? "REGRESSED" : "ok";
+      regressed = regressed || worse;
+      base_allocations = to_string(it->second.first);
+      base_bytes = to_string(it->second.second);
+    }
+    report.add(m.name, to_string(m.allocations), to_string(m.bytes), base_allocations, base_bytes, status);
+    if (status == "REGRESSED") {
+      report[report.size() - 1][5].format().color(Color::red);
+    }
+  }
+  std::cout << report.xterm() << std::endl;
+
+  if (update) {
+    std::ofstream out(argv[1]);
+    out << "# allocations and bytes per added row or rendered cell, written by tabulate-bench-allocations --update" << std::endl;
+    for (auto const &m : measures) {
+      out << m.name << '\t' << m.allocations << '\t' << m.bytes << std::endl;
+    }
+  }
+
+  return regressed ? 1 : 0;
+}
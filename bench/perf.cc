@@ -0,0 +1,241 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include "tabulate.h"
+using namespace tabulate;
+
+// fixed seed: the same tables on every run
+static std::mt19937 rng(20221104);
+
+std::string word(size_t min, size_t max)
+{
+  static const char letters[] = "abcdefghijklmnopqrstuvwxyz";
+  std::string str(min + rng() % (max - min + 1), ' ');
+  for (auto &c : str) {
+    c = letters[rng() % 26];
+  }
+  return str;
+}
+
+std::string sentence(size_t words)
+{
+  std::string str;
+  for (size_t i = 0; i < words; i++) {
+    str += (i == 0 ? "" : " ") + word(2, 9);
+  }
+  return str;
+}
+
+Table wide()
+{
+  Table table;
+  for (size_t i = 0; i < 6; i++) {
+    std::vector<std::string> values;
+    for (size_t j = 0; j < 60; j++) {
+      values.push_back(word(1, 8));
+    }
+    table.add_multiple(values);
+  }
+  return table;
+}
+
+Table tall()
+{
+  Table table;
+  table.add("Id", "Name", "Value", "Comment");
+  for (size_t i = 0; i < 1000; i++) {
+    table.add(to_string(i), word(4, 12), to_string(rng() % 100000), sentence(1 + rng() % 4));
+  }
+  table.column(3).format().width(24);
+  return table;
+}
+
+Table cjk()
+{
+  static const char *glyphs[] = {"表", "格", "数", "据", "中", "文", "字", "符", "テ", "ス", "ト", "한", "글"};
+  Table table;
+  table.add("Key", "Value", "Note");
+  for (size_t i = 0; i < 200; i++) {
+    std::string value, note;
+    for (size_t k = 0; k < 2 + rng() % 6; k++) {
+      value += glyphs[rng() % 13];
+    }
+    for (size_t k = 0; k < 10 + rng() % 20; k++) {
+      note += glyphs[rng() % 13];
+    }
+    table.add(word(3, 6), value, note);
+  }
+  table.column(2).format().width(20);
+  table.format().multi_bytes_character(true);
+  return table;
+}
+
+Table ansi()
+{
+  static const Color colors[] = {Color::red, Color::green, Color::yellow, Color::blue, Color::magenta, Color::cyan};
+  Table table;
+  table.add("Status", "Host", "Message");
+  for (size_t i = 0; i < 200; i++) {
+    // content carrying its own escape sequences, as in captured command output
+    std::string status = "\033[1;3" + to_string(1 + rng() % 6) + "m" + word(2, 6) + "\033[0m";
+    table.add(status, word(5, 10), sentence(3));
+    table[i + 1][1].format().color(colors[rng() % 6]).background_color(TrueColor(static_cast<int>(rng() % 0xFFFFFF)));
+    table[i + 1][2].format().styles(Style::italic, Style::underline);
+  }
+  table[0].format().styles(Style::bold);
+  return table;
+}
+
+Table nested()
+{
+  Table table;
+  table.add("Group", "Members");
+  for (size_t i = 0; i < 40; i++) {
+    Table members;
+    for (size_t k = 0; k < 3; k++) {
+      members.add(word(3, 8), to_string(rng() % 100));
+    }
+    table.add(word(4, 8), members);
+  }
+  return table;
+}
+
+Table merged()
+{
+  Table table;
+  for (size_t i = 0; i < 100; i++) {
+    table.add(word(2, 6), word(2, 6), word(2, 6), word(2, 6));
+  }
+  for (int i = 1; i + 1 < 100; i += 4) {
+    table.merge(std::make_tuple(i, 0), std::make_tuple(i + 1, 1));
+  }
+  return table;
+}
+
+// best of a few runs in nanoseconds
+template <typename Function>
+double best_of(Function function, size_t runs = 5)
+{
+  double best = 0;
+  for (size_t i = 0; i < runs; i++) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    best = (i == 0 || elapsed < best) ? elapsed : best;
+  }
+  return best;
+}
+
+// a fixed workload measured on the same machine, timings are kept relative to it
+double calibrate()
+{
+  return best_of([]() {
+    std::mt19937 local(1);
+    std::vector<std::string> strings;
+    for (size_t i = 0; i < 20000; i++) {
+      strings.push_back(std::to_string(local()));
+    }
+    std::sort(strings.begin(), strings.end());
+    std::string joined;
+    for (auto const &str : strings) {
+      joined += str + "\n";
+    }
+    volatile size_t size = joined.size();
+    (void)size;
+  });
+}
+
+int main(int argc, char *argv[])
+{
+  std::vector<std::pair<std::string, Table>> tables = {
+      {"wide", wide()}, {"tall", tall()}, {"cjk", cjk()}, {"ansi", ansi()}, {"nested", nested()}, {"merged", merged()},
+  };
+
+  // warm up the per-thread render caches
+  for (auto &table : tables) {
+    table.second.xterm(ColorMode::truecolor);
+  }
+
+  double unit = calibrate();
+  std::vector<std::pair<std::string, double>> measures;
+  for (auto &entry : tables) {
+    const Table &table = entry.second;
+    std::string exported;
+    measures.push_back({entry.first + "/xterm", best_of([&]() { exported = table.xterm(ColorMode::truecolor); }) / unit});
+    measures.push_back({entry.first + "/xterm-paged", best_of([&]() { exported = table.xterm(40, true); }) / unit});
+    measures.push_back({entry.first + "/markdown", best_of([&]() { exported = table.markdown(); }) / unit});
+    measures.push_back({entry.first + "/latex", best_of([&]() { exported = table.latex(); }) / unit});
+  }
+
+  // baseline file: one "name<TAB>time relative to the calibration workload" line per measure
+  // timing noise: relative tolerance, plus absolute slack for the shortest measures
+  const double TOLERANCE = 0.50, SLACK = 0.005;
+  std::map<std::string, double> baseline;
+  bool update = argc > 2 && std::string(argv[2]) == "--update";
+  if (argc > 1 && !update) {
+    std::ifstream in(argv[1]);
+    std::string line;
+    while (std::getline(in, line)) {
+      size_t tab = line.find('\t');
+      if (!line.empty() && line[0] != '#' && tab != std::string::npos) {
+        baseline[line.substr(0, tab)] = atof(line.substr(tab + 1).c_str());
+      }
+    }
+  }
+
+  bool regressed = false;
+  Table report;
+  report.add("Measure", "Time (us)", "Relative", "Baseline", "Status");
+  report[0].format().styles(Style::bold);
+  for (auto const &m : measures) {
+    auto it = baseline.find(m.first);
+    std::string status = "no baseline", base = "-";
+    if (it != baseline.end()) {
+      bool slower = m.second > it->second * (1 + TOLERANCE) + SLACK;
+      status = slower ? "REGRESSED" : "ok";
+      regressed = regressed || slower;
+      base = to_string(it->second);
+    }
+    report.add(m.first, to_string(m.second * unit / 1000), to_string(m.second), base, status);
+  }
+  report.column(1).format().align(Align::right);
+  report.column(2).format().align(Align::right);
+  report.column(3).format().align(Align::right);
+  std::cout << report.xterm() << std::endl;
+
+  if (update) {
+    std::ofstream out(argv[1]);
+    out << "# render time relative to the calibration workload, written by tabulate-perf --update" << std::endl;
+    for (auto const &m : measures) {
+      out << m.first << '\t' << m.second << std::endl;
+    }
+  }
+
+  // wall-clock timings vary on loaded machines, regressions only fail the run when asked for
+  const char *gate = std::getenv("TABULATE_PERF_GATE");
+  bool gated = gate != nullptr && std::string(gate) == "1";
+  if (regressed && !gated) {
+    std::cout << "regressions reported only, set TABULATE_PERF_GATE=1 to fail on them" << std::endl;
+  }
+
+  return regressed && gated ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fuzz.h"
+#include "tabulate.h"
+using namespace tabulate;
+
+// Row::dump on cells with arbitrary content and formats
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  if (size < 4) {
+    return 0;
+  }
+  size_t columns = 1 + data[0] % 6;
+  bool multi_bytes_character = data[1] & 1;
+  size_t padding = (data[1] >> 1) % 3;
+  static const Align aligns[] = {Align::left, Align::center, Align::right, Align::top, Align::bottom};
+  Align align = aligns[data[2] % 5];
+  size_t width = 1 + data[3] % 40;
+
+  // cells are separated by \x1f
+  std::string text(reinterpret_cast<const char *>(data + 4), size - 4);
+  Row row;
+  bool ascii = true;
+  size_t start = 0;
+  for (size_t j = 0; j < columns; j++) {
+    size_t end = text.find('\x1f', start);
+    std::string content = text.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    start = end == std::string::npos ? text.size() : end + 1;
+    for (char c : content) {
+      ascii = ascii && c >= ' ' && c <= '~';
+    }
+    row[j].set(content);
+    row[j].format().width(width + j).align(align).border_padding(padding).multi_bytes_character(multi_bytes_character);
+  }
+
+  TimeBound bound("Row::dump", size);
+  auto lines = row.dump(xterm::stringformatter, xterm::borderformatter, xterm::cornerformatter, 0, 1, 1);
+
+  FUZZ_CHECK(!lines.empty(), "a row has lines");
+  FUZZ_CHECK(lines.size() <= 2 * text.size() + 2 * padding + 3, "line count");
+  size_t bytes = 0;
+  for (auto const &line : lines) {
+    bytes += line.size();
+  }
+  // columns of every line: cells, paddings and borders, each at most a few escaped bytes
+  size_t columns_per_line = 0;
+  for (size_t j = 0; j < columns; j++) {
+    columns_per_line += width + j + 2 * padding + 2;
+  }
+  FUZZ_CHECK(bytes <= (64 * columns_per_line + text.size()) * lines.size(), "output size");
+
+  // measured without rendering
+  size_t line_count = 0;
+  size_t measured = row.dumped_size(xterm::stringformatter, xterm::borderformatter, xterm::cornerformatter, 0, 1, nullptr, nullptr, line_count);
+  FUZZ_CHECK(measured == bytes && line_count == lines.size(), "dumped_size matches dump");
+
+  // printable ascii content lays out in a rectangle
+  if (ascii) {
+    size_t expected = display_width_of(lines[0], "", true);
+    for (auto const &line : lines) {
+      FUZZ_CHECK(display_width_of(line, "", true) == expected, "lines have the same width");
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+// libFuzzer entry point, also driven by standalone.cc where libFuzzer is not available
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+#define FUZZ_CHECK(condition, message)                                                            \
+  do {                                                                                            \
+    if (!(condition)) {                                                                           \
+      fprintf(stderr, "%s:%d: check failed: %s (%s)\n", __FILE__, __LINE__, #condition, message); \
+      abort();                                                                                    \
+    }                                                                                             \
+  } while (0)
+
+// aborts when a call runs longer than linear in the input allows
+class TimeBound {
+ public:
+  TimeBound(const char *name, size_t size) : name(name), budget(100000 + 20 * size), start(std::chrono::steady_clock::now()) {}
+
+  ~TimeBound()
+  {
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    if (static_cast<uint64_t>(elapsed) > budget) {
+      fprintf(stderr, "%s took %lld us, more than the %llu us allowed\n", name, static_cast<long long>(elapsed), static_cast<unsigned long long>(budget));
+      abort();
+    }
+  }
+
+ private:
+  const char *name;
+  uint64_t budget; // microseconds
+  std::chrono::steady_clock::time_point start;
+};
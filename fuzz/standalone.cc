@@ -0,0 +1,106 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <random>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+#include <dirent.h>
+#include "fuzz.h"
+
+// Runs a fuzz target without libFuzzer: over the files given on the command
+// line (a crash reproducer or a corpus directory), or else over inputs built
+// from a fixed seed, biased towards the pathological shapes of table text.
+
+static std::string read_file(const std::string &path)
+{
+  std::ifstream in(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+static void run(const std::string &input)
+{
+  LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t *>(input.data()), input.size());
+}
+
+static std::string generate(std::mt19937 &rng, size_t size)
+{
+  static const std::string pieces[] = {
+      " ", "-", "\t", "\n", "\x1f", "word", "\033[1;31m", "\033[00m", "\033[38:2:1:2:3m", "\033", "表", "─", "\xe2\x94", "\xff", "\x80", "\xf0\x9f\x94\xa5",
+  };
+  std::string input;
+  input += static_cast<char>(rng());
+  input += static_cast<char>(rng());
+  input += static_cast<char>(rng());
+  input += static_cast<char>(rng());
+  switch (rng() % 4) {
+    case 0: // a long unbreakable word
+      input += std::string(size, 'a' + rng() % 26);
+      break;
+    case 1: // nothing but separators
+      for (size_t i = 0; i < size; i++) {
+        input += " -\t"[rng() % 3];
+      }
+      break;
+    default: // a mix of words, escapes and invalid UTF-8
+      while (input.size() < size) {
+        input += pieces[rng() % (sizeof(pieces) / sizeof(pieces[0]))];
+      }
+      break;
+  }
+  return input;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) {
+      struct stat st;
+      if (stat(argv[i], &st) == 0 && S_ISDIR(st.st_mode)) {
+        if (DIR *dir = opendir(argv[i])) {
+          while (struct dirent *entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') {
+              run(read_file(std::string(argv[i]) + "/" + entry->d_name));
+            }
+          }
+          closedir(dir);
+        }
+      } else {
+        run(read_file(argv[i]));
+      }
+    }
+    return 0;
+  }
+
+  // inputs of fixed bugs, a width byte and a flags byte before the text
+  static const std::string regressions[] = {
+      std::string("\x02\x01") + "表表表表", // wide glyphs as wide as the line took a hyphen
+  };
+  size_t runs = 0;
+  for (auto const &input : regressions) {
+    run(input);
+    runs++;
+  }
+
+  std::mt19937 rng(20221104);
+  for (size_t size : {0, 1, 4, 16, 64, 256, 1024, 4096, 16384}) {
+    for (size_t i = 0; i < 24; i++, runs++) {
+      run(generate(rng, size));
+    }
+  }
+  std::cout << runs << " inputs passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fuzz.h"
+#include "tabulate.h"
+using namespace tabulate;
+
+// wrap_lines, explode_string, expand_to_size and display_width_of on arbitrary text
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  if (size < 2) {
+    return 0;
+  }
+  size_t width = data[0] % 64;
+  bool multi_bytes_character = data[1] & 1;
+  std::string text(reinterpret_cast<const char *>(data + 2), size - 2);
+
+  {
+    TimeBound bound("display_width_of", text.size());
+    size_t plain = display_width_of(text, "", false);
+    size_t wide = display_width_of(text, "", true);
+    FUZZ_CHECK(plain <= text.size(), "a byte is at most one column");
+    FUZZ_CHECK(wide <= 2 * text.size(), "a glyph is at most two columns");
+  }
+
+  {
+    TimeBound bound("explode_string", text.size());
+    auto segments = explode_string(text, {" ", "-", "\t"});
+    std::string joined;
+    for (auto const &segment : segments) {
+      joined += segment;
+    }
+    FUZZ_CHECK(joined == text, "segments join back to the input");
+    FUZZ_CHECK(segments.size() <= 2 * text.size() + 1, "segment count");
+  }
+
+  bool ascii = true;
+  for (char c : text) {
+    ascii = ascii && ((c >= ' ' && c <= '~') || c == '\n');
+  }
+
+  // printable ASCII and complete UTF-8 sequences, glyphs are at most two columns wide
+  bool utf8 = true;
+  for (size_t i = 0; i < text.size() && utf8;) {
+    unsigned char c = static_cast<unsigned char>(text[i]);
+    size_t length = c >= 0xF0 && c <= 0xF4 ? 4 : c >= 0xE0 ? 3 : c >= 0xC2 && c < 0xE0 ? 2 : 1;
+    utf8 = (length > 1 || (c >= ' ' && c <= '~') || c == '\n') && c < 0xF5 && i + length <= text.size();
+    for (size_t k = 1; k < length && utf8; k++) {
+      utf8 = (static_cast<unsigned char>(text[i + k]) & 0xC0) == 0x80;
+    }
+    i += length;
+  }
+
+  {
+    TimeBound bound("wrap_lines", text.size());
+    auto lines = wrap_lines(text, width, "", multi_bytes_character);
+    size_t bytes = 0;
+    for (auto const &line : lines) {
+      bytes += line.size();
+      if (ascii) {
+        FUZZ_CHECK(display_width_of(line, "", multi_bytes_character) <= std::max<size_t>(width, 1), "line width");
+      } else if (utf8 && multi_bytes_character) {
+        FUZZ_CHECK(display_width_of(line, "", true) <= std::max<size_t>(width, 2), "line width of wide glyphs");
+      }
+    }
+    FUZZ_CHECK(lines.size() <= 2 * text.size() + 2, "line count");
+    FUZZ_CHECK(bytes <= 2 * text.size() + lines.size(), "output size");
+  }
+
+  {
+    TimeBound bound("expand_to_size", text.size() + width);
+    std::string pattern = text.substr(0, 16);
+    std::string expanded = expand_to_size(pattern, width, multi_bytes_character);
+    FUZZ_CHECK(expanded.size() <= std::max<size_t>(1, pattern.size()) * (width + 1), "output size");
+    if (pattern.empty()) {
+      FUZZ_CHECK(expanded == std::string(width, ' '), "empty patterns expand to spaces");
+    }
+    bool printable = true;
+    for (char c : pattern) {
+      printable = printable && c >= ' ' && c <= '~';
+    }
+    if (printable && width > 0) {
+      FUZZ_CHECK(display_width_of(expanded, "", false) == width || pattern.empty(), "ascii patterns fill the width");
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include "../samples/common/tables.h"
+
+// Renders the tables of the samples through every exporter, compares the
+// output byte for byte with the files in golden/expected and reports the
+// render throughput. Pass --update to rewrite the expected files.
+
+static std::string read_file(const std::string &path)
+{
+  std::ifstream in(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+// first line where two outputs differ, 0 if they are equal
+static size_t first_difference(const std::string &a, const std::string &b)
+{
+  size_t line = 1;
+  for (size_t i = 0; i < std::min(a.size(), b.size()); i++) {
+    if (a[i] != b[i]) {
+      return line;
+    }
+    line += a[i] == '\n';
+  }
+  return a.size() == b.size() ? 0 : line;
+}
+
+// MB/s over repeated renders, at least 20ms of them
+template <typename Function>
+double throughput(size_t bytes, Function function)
+{
+  size_t runs = 0;
+  auto start = std::chrono::steady_clock::now();
+  double elapsed = 0;
+  do {
+    function();
+    runs++;
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  } while (elapsed < 0.02);
+  return bytes * runs / elapsed / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0] << " <expected directory> [--update]" << std::endl;
+    return 2;
+  }
+  std::string directory = argv[1];
+  bool update = argc > 2 && std::string(argv[2]) == "--update";
+
+  // the output must not depend on the terminal running the test
+  RenderProfile profile;
+  profile.color = ColorMode::truecolor;
+  profile.unicode = true;
+  profile.no_color = false;
+  profile.isatty = true;
+
+  struct Exporter {
+    std::string extension;
+    tabulate::Exporter kind;
+    std::function<std::string(const Table &)> render;
+  };
+  std::vector<Exporter> exporters = {
+      {"xterm", tabulate::Exporter::xterm, [&](const Table &table) { return table.xterm(profile); }},
+      {"md", tabulate::Exporter::markdown, [](const Table &table) { return table.markdown(); }},
+      {"tex", tabulate::Exporter::latex, [](const Table &table) { return table.latex(); }},
+  };
+
+  bool passed = true;
+  Table report;
+  report.add("Table", "Exporter", "Bytes", "MB/s", "Status");
+  report[0].format().styles(Style::bold);
+  for (auto const &entry : samples::tables()) {
+    for (auto const &exporter : exporters) {
+      std::string path = directory + "/" + entry.first + "." + exporter.extension;
+      std::string rendered = exporter.render(entry.second);
+
+      std::string status = "ok";
+      if (update) {
+        std::ofstream(path, std::ios::binary) << rendered;
+        status = "updated";
+      } else if (size_t line = first_difference(rendered, read_file(path))) {
+        status = "differs at line " + to_string(line);
+        passed = false;
+      } else if (size_t size = entry.second.rendered_size(exporter.kind, profile); size != rendered.size()) {
+        status = "rendered_size() is " + to_string(size);
+        passed = false;
+      }
+
+      double mbps = throughput(rendered.size(), [&]() { exporter.render(entry.second); });
+      report.add(entry.first, exporter.extension, to_string(rendered.size()), to_string(mbps), status);
+      if (status != "ok" && status != "updated") {
+        report[report.size() - 1][4].format().color(Color::red);
+      }
+    }
+  }
+  report.column(2).format().align(Align::right);
+  report.column(3).format().align(Align::right);
+  std::cout << report.xterm(profile) << std::endl;
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include "tabulate.h"
+using namespace tabulate;
+
+// a destination that takes a while for every write, like a slow disk or a full pipe
+class SlowSink : public Sink {
+ public:
+  explicit SlowSink(std::string &target) : target(target) {}
+
+  using Sink::write;
+  void write(const char *data, size_t size) override
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    target.append(data, size);
+    writes++;
+  }
+
+  std::string &target;
+  size_t writes = 0;
+};
+
+// passes buffers on to a FileSink and tracks how much of them is not yet in the file
+class HeldProbe : public Sink {
+ public:
+  HeldProbe(FileSink &out, FILE *file) : out(out), file(file) {}
+
+  using Sink::write;
+  void write(const char *data, size_t size) override
+  {
+    out.write(data, size);
+    __measure(size);
+  }
+  void write_owned(std::string &&data) override
+  {
+    size_t size = data.size();
+    out.write_owned(std::move(data));
+    __measure(size);
+  }
+  void flush() override
+  {
+    out.flush();
+  }
+
+  size_t most_held = 0;
+
+ private:
+  void __measure(size_t size)
+  {
+    passed += size;
+    std::fseek(file, 0, SEEK_END);
+    most_held = std::max(most_held, passed - static_cast<size_t>(std::ftell(file)));
+  }
+
+  FileSink &out;
+  FILE *file;
+  size_t passed = 0;
+};
+
+class FailingSink : public Sink {
+ public:
+  using Sink::write;
+  void write(const char *, size_t) override
+  {
+    throw std::runtime_error("disk full");
+  }
+};
+
+int main()
+{
+  Table inventory;
+  inventory.add("SKU", "Item", "Warehouse", "Quantity");
+  inventory[0].format().color(Color::yellow).styles(Style::bold);
+  for (size_t i = 0; i < 1000; i++) {
+    inventory.add("SKU-" + to_string(100000 + i), "item " + to_string(i * 37 % 1009), "WH-" + to_string(i % 9), to_string(i * 13 % 500));
+  }
+  std::string expected = inventory.xterm();
+
+  // rendering continues while the writer thread waits on the destination
+  std::string slow;
+  SlowSink destination(slow);
+  {
+    AsyncSink async(destination, 4, 16 * 1024);
+    inventory.xterm(async);
+    async.flush();
+  }
+  std::cout << "wrote " << slow.size() << " bytes in " << destination.writes << " writes" << std::endl;
+
+  // every 64 KiB buffer reaches the byte threshold of FileSink and goes out with its own writev()
+  bool written = false;
+  if (FILE *file = std::tmpfile()) {
+    size_t most_held;
+    {
+      FileSink out(fileno(file));
+      HeldProbe probe(out, file);
+      AsyncSink async(probe);
+      inventory.xterm(async);
+      async.flush();
+      most_held = probe.most_held;
+    }
+    std::string content(expected.size() + 1, '\0');
+    std::rewind(file);
+    content.resize(std::fread(&content[0], 1, content.size(), file));
+    std::fclose(file);
+    std::cout << "at most " << most_held << " of " << expected.size() << " bytes held by the FileSink" << std::endl;
+    written = content == expected && most_held < 64 * 1024;
+  }
+
+  // errors of the writer thread surface in the rendering thread
+  bool reported = false;
+  FailingSink full;
+  try {
+    AsyncSink async(full, 2, 1024);
+    inventory.xterm(async);
+    async.flush();
+  } catch (const std::runtime_error &e) {
+    std::cout << "writer failed: " << e.what() << std::endl;
+    reported = true;
+  }
+
+  return slow == expected && written && reported ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <iostream>
+#include "tabulate.h"
+using namespace tabulate;
+
+int main()
+{
+  // the cells hold the numbers, the column draws them as bars
+  Table disks;
+  disks.add("Mount", "Used", "Usage");
+  disks.add("/", "37.5%", 37.5);
+  disks.add("/home", "81%", 81);
+  disks.add("/var", "3.1%", 3.1);
+  disks.add("/boot", "50%", 50);
+  disks.add("/mnt/backup", "n/a", "offline");
+  disks[0].format().styles(Style::bold);
+  disks.column(1).format().align(Align::right);
+  disks.column(2).format().width(20).color(Color::green);
+  disks.bar(2, 0, 100);
+
+  std::cout << disks.xterm() << std::endl;
+
+  // from 0 to the largest value
+  Table downloads;
+  downloads.add("Package", "Downloads");
+  downloads.add("tabulate", 18230);
+  downloads.add("fmt", 94120);
+  downloads.add("spdlog", 61005);
+  downloads.column(1).format().width(30);
+  downloads.bar(1);
+
+  std::cout << downloads.xterm() << std::endl;
+
+  // 50 of 100 over 20 characters is 10 full blocks, 37.5 is 7 and a half
+  std::string rendered = disks.xterm(true);
+  bool half = rendered.find(" ██████████          ") != std::string::npos;
+  bool eighths = rendered.find(" ███████▌            ") != std::string::npos;
+  bool text = rendered.find(" offline ") != std::string::npos;
+  return half && eighths && text ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include "tabulate.h"
+using namespace tabulate;
+
+int main()
+{
+  // one small table per host
+  std::vector<Table> hosts(2000);
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    Table &host = hosts[i];
+    host.add("Host", "CPU", "Memory", "Status");
+    host.add("node-" + to_string(i), to_string(i % 100) + "%", to_string(i * 7 % 64) + " GiB", i % 13 == 0 ? "degraded" : "ok");
+    host[0].format().color(Color::yellow).styles(Style::bold);
+    if (i % 13 == 0) {
+      host[1][3].format().color(Color::red);
+    }
+  }
+
+  std::string sequential;
+  for (auto const &host : hosts) {
+    sequential += host.xterm();
+  }
+
+  // all jobs share one sink, output keeps the order of the jobs
+  std::string report;
+  StringSink sink(report);
+  std::vector<RenderJob> jobs;
+  for (auto const &host : hosts) {
+    jobs.push_back({&host, &sink});
+  }
+  render_batch(jobs, 4);
+
+  // or every table goes to a sink of its own
+  std::vector<std::string> outputs(hosts.size());
+  std::vector<std::unique_ptr<StringSink>> sinks;
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    sinks.emplace_back(new StringSink(outputs[i]));
+    jobs[i].sink = sinks[i].get();
+  }
+  render_batch(jobs);
+
+  std::string joined;
+  for (auto const &output : outputs) {
+    joined += output;
+  }
+
+  std::cout << hosts[0].xterm() << std::endl;
+  std::cout << hosts[13].xterm() << std::endl;
+
+  return report == sequential && joined == sequential ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <iostream>
+#include <map>
+#include "tabulate.h"
+using namespace tabulate;
+
+int main()
+{
+  // a mushroom, one letter per pixel
+  std::vector<std::string> sprite = {
+      "     kkkkkk     ", "   kkrrrrwwkk   ", "  kwwrrrrwwwwk  ", " kwwrrrrrrwwwwk ", " krrrwwwwrrwwwk ", "krrrwwwwwwrrrrrk",
+      "krrrwwwwwwrrwwrk", "kwrrwwwwwwrwwwwk", "kwwrrwwwwrrwwwwk", "kwwrrrrrrrrrwwrk", "kwrrkkkkkkkkrrrk", " kkkwwkwwkwwkkk ",
+      "  kwwwkwwkwwwk  ", "  kwwwwwwwwwwk  ", "   kkkkkkkkkk   ",
+  };
+  std::map<char, TrueColor> palette = {{'k', 0x000000}, {'r', 0xD82800}, {'w', 0xFCFCFC}};
+  std::vector<std::vector<TrueColor>> pixels;
+  for (auto const &line : sprite) {
+    pixels.emplace_back();
+    for (char c : line) {
+      pixels.back().push_back(c == ' ' ? TrueColor() : palette[c]);
+    }
+  }
+
+  RenderProfile profile;
+  profile.color = ColorMode::truecolor;
+  Canvas mushroom(pixels);
+  std::cout << mushroom.xterm(profile) << std::endl;
+
+  // the same pixels as a table of one cell each
+  Table cells;
+  for (auto const &row : pixels) {
+    Row &added = cells.add_multiple(std::vector<std::string>(row.size(), std::string(symbols::horizontal_eighths[8])));
+    for (size_t x = 0; x < row.size(); x++) {
+      added[x].format().color(row[x]);
+    }
+  }
+  cells.format().border("").corner("").border_padding(0).hide_border().multi_bytes_character(true);
+  std::string table = cells.xterm(profile);
+  std::string canvas = mushroom.xterm(profile);
+  std::cout << "canvas: " << canvas.size() << " bytes, table: " << table.size() << " bytes" << std::endl;
+
+  // the top pixel is the foreground, equal pixels are a full block, escapes only on changes
+  Canvas tiny(4, 2);
+  tiny.set(0, 0, 0xFF0000).set(1, 0, 0xFF0000).set(1, 1, 0xFF0000).set(2, 0, 0x0000FF).set(2, 1, 0x00FF00).set(3, 1, 0x00FF00);
+  std::string expected = "\033[38:2:255:0:0m▀█\033[38:2:0:0:255m\033[48:2:0:255:0m▀\033[00m\033[38:2:0:255:0m▄\033[00m";
+
+  return tiny.xterm(profile) == expected && canvas.size() * 3 < table.size() ? 0 : 1;
+}
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <iostream>
 #include "tabulate.h"
 using namespace tabulate;
 
@@ -47,5 +49,56 @@ int main()
   colors[2][2].format().background_color(Color::green).styles(Style::bold);
 
   std::cout << colors.xterm() << std::endl;
+
+  // the same table for a terminal limited to the 256 color palette
+  std::cout << colors.xterm(ColorMode::xterm256) << std::endl;
+
+  // and for a log file without escape sequences or box drawing glyphs
+  RenderProfile plain;
+  plain.color = ColorMode::none;
+  plain.unicode = false;
+  std::string logged = colors.xterm(plain);
+  std::cout << logged << std::endl;
+
+  // the formatters pick ASCII glyphs that take the columns of the box drawing ones
+  std::string boxed = colors.xterm(ColorMode::none);
+  for (unsigned char c : logged) {
+    if (c >= 0x80) {
+      return 1;
+    }
+  }
+  if (std::count(logged.begin(), logged.end(), '\n') != std::count(boxed.begin(), boxed.end(), '\n') ||
+      logged.substr(0, logged.find('\n')).size() != display_width_of(boxed.substr(0, boxed.find('\n')), "", true)) {
+    return 1;
+  }
   // std::cout << "Markdown Table:\n" << colors.markdown() << std::endl;
+
+  // basic mode keeps near black colors on the terminal default
+  for (int hex : {0x000000, 0x101010, 0x202020, 0x303030, 0x0a0a40, 0x400000}) {
+    if (TrueColor::most_similar(TrueColor(hex)) != Color::none) {
+      return 1;
+    }
+  }
+
+  // and picks the basic color closest by similarity(), the first one on ties
+  const Color candidates[] = {Color::black, Color::red,  Color::green, Color::yellow, Color::blue,
+                              Color::magenta, Color::cyan, Color::white, Color::none};
+  for (int r = 0; r < 256; r += 17) {
+    for (int g = 0; g < 256; g += 17) {
+      for (int b = 0; b < 256; b += 17) {
+        TrueColor color((r << 16) | (g << 8) | b);
+        Color nearest = candidates[0];
+        for (Color candidate : candidates) {
+          if (TrueColor::similarity(color, candidate) < TrueColor::similarity(color, nearest)) {
+            nearest = candidate;
+          }
+        }
+        if (TrueColor::most_similar(color) != nearest) {
+          return 1;
+        }
+      }
+    }
+  }
+
+  return 0;
 }
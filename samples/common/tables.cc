@@ -0,0 +1,579 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tables.h"
+
+// The tables printed by the samples and compared by golden/golden.cc.
+namespace samples
+{
+Table mario()
+{
+  Table mario;
+  size_t rows = 16;
+  for (size_t i = 0; i < rows; ++i) {
+    mario.add("█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█", "█",
+              "█");
+  }
+  mario.format().color(Color::white).border("").corner("").border_padding(0).hide_border();
+
+  // Row 0
+  for (size_t i = 7; i < 20; ++i) {
+    mario[0][i].format().color(Color::red);
+  }
+  // Row 1
+  for (size_t i = 5; i < 26; ++i) {
+    mario[1][i].format().color(Color::red);
+  }
+  // Row 2
+  for (size_t i = 5; i < 13; ++i) {
+    mario[2][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 13; i < 18; ++i) {
+    mario[2][i].format().color(Color::yellow);
+  }
+  for (size_t i = 18; i < 20; ++i) {
+    mario[2][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 20; i < 22; ++i) {
+    mario[2][i].format().color(Color::yellow);
+  }
+  // Row 3
+  for (size_t i = 3; i < 7; ++i) {
+    mario[3][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 7; i < 9; ++i) {
+    mario[3][i].format().color(Color::yellow);
+  }
+  for (size_t i = 9; i < 11; ++i) {
+    mario[3][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 11; i < 18; ++i) {
+    mario[3][i].format().color(Color::yellow);
+  }
+  for (size_t i = 18; i < 20; ++i) {
+    mario[3][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 20; i < 26; ++i) {
+    mario[3][i].format().color(Color::yellow);
+  }
+  // Row 4
+  for (size_t i = 3; i < 7; ++i) {
+    mario[4][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 7; i < 9; ++i) {
+    mario[4][i].format().color(Color::yellow);
+  }
+  for (size_t i = 9; i < 13; ++i) {
+    mario[4][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 13; i < 20; ++i) {
+    mario[4][i].format().color(Color::yellow);
+  }
+  for (size_t i = 20; i < 22; ++i) {
+    mario[4][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 22; i < 28; ++i) {
+    mario[4][i].format().color(Color::yellow);
+  }
+  // Row 5
+  for (size_t i = 3; i < 9; ++i) {
+    mario[5][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 9; i < 18; ++i) {
+    mario[5][i].format().color(Color::yellow);
+  }
+  for (size_t i = 18; i < 26; ++i) {
+    mario[5][i].format().color(Color::green).styles(Style::faint);
+  }
+  // Row 6
+  for (size_t i = 7; i < 24; ++i) {
+    mario[6][i].format().color(Color::yellow);
+  }
+  // Row 7
+  for (size_t i = 5; i < 11; ++i) {
+    mario[7][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 11; i < 13; ++i) {
+    mario[7][i].format().color(Color::red);
+  }
+  for (size_t i = 13; i < 20; ++i) {
+    mario[7][i].format().color(Color::green).styles(Style::faint);
+  }
+  // Row 8
+  for (size_t i = 3; i < 11; ++i) {
+    mario[8][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 11; i < 13; ++i) {
+    mario[8][i].format().color(Color::red);
+  }
+  for (size_t i = 13; i < 18; ++i) {
+    mario[8][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 18; i < 20; ++i) {
+    mario[8][i].format().color(Color::red);
+  }
+  for (size_t i = 20; i < 26; ++i) {
+    mario[8][i].format().color(Color::green).styles(Style::faint);
+  }
+  // Row 9
+  for (size_t i = 1; i < 11; ++i) {
+    mario[9][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 11; i < 20; ++i) {
+    mario[9][i].format().color(Color::red);
+  }
+  for (size_t i = 20; i < 29; ++i) {
+    mario[9][i].format().color(Color::green).styles(Style::faint);
+  }
+  // Row 10
+  for (size_t i = 1; i < 7; ++i) {
+    mario[10][i].format().color(Color::yellow);
+  }
+  for (size_t i = 7; i < 9; ++i) {
+    mario[10][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 9; i < 11; ++i) {
+    mario[10][i].format().color(Color::red);
+  }
+  for (size_t i = 11; i < 13; ++i) {
+    mario[10][i].format().color(Color::yellow);
+  }
+  for (size_t i = 13; i < 18; ++i) {
+    mario[10][i].format().color(Color::red);
+  }
+  for (size_t i = 18; i < 20; ++i) {
+    mario[10][i].format().color(Color::yellow);
+  }
+  for (size_t i = 20; i < 22; ++i) {
+    mario[10][i].format().color(Color::red);
+  }
+  for (size_t i = 22; i < 24; ++i) {
+    mario[10][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 24; i < 29; ++i) {
+    mario[10][i].format().color(Color::yellow);
+  }
+  // Row 11
+  for (size_t i = 1; i < 9; ++i) {
+    mario[11][i].format().color(Color::yellow);
+  }
+  for (size_t i = 9; i < 22; ++i) {
+    mario[11][i].format().color(Color::red);
+  }
+  for (size_t i = 22; i < 29; ++i) {
+    mario[11][i].format().color(Color::yellow);
+  }
+  // Row 12
+  for (size_t i = 1; i < 7; ++i) {
+    mario[12][i].format().color(Color::yellow);
+  }
+  for (size_t i = 24; i < 29; ++i) {
+    mario[12][i].format().color(Color::yellow);
+  }
+  for (size_t i = 7; i < 24; ++i) {
+    mario[12][i].format().color(Color::red);
+  }
+  // Row 13
+  for (size_t i = 5; i < 14; ++i) {
+    mario[13][i].format().color(Color::red);
+  }
+  for (size_t i = 16; i < 24; ++i) {
+    mario[13][i].format().color(Color::red);
+  }
+  // Row 14
+  for (size_t i = 3; i < 12; ++i) {
+    mario[14][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 18; i < 26; ++i) {
+    mario[14][i].format().color(Color::green).styles(Style::faint);
+  }
+  // Row 15
+  for (size_t i = 1; i < 12; ++i) {
+    mario[15][i].format().color(Color::green).styles(Style::faint);
+  }
+  for (size_t i = 18; i < 29; ++i) {
+    mario[15][i].format().color(Color::green).styles(Style::faint);
+  }
+  mario.format().multi_bytes_character(true);
+
+  return mario;
+}
+
+Table summary()
+{
+  Table readme;
+  readme.set_title("tabulate for Modern C++");
+  {
+    Row &row = readme.add("https://github.com/tqolf/tabulate");
+    row.format().color(Color::white).align(Align::center).styles(Style::underline, Style::italic);
+  }
+
+  {
+    Row &row = readme.add("Tabulate is a header-only library for printing aligned, formatted, and "
+                          "colorized tables in Modern C++");
+    row.format().styles(Style::italic).color(Color::magenta);
+  }
+
+  {
+    Table highlights;
+    highlights.add("Header-only Library", "Requires C++11", "Apache License");
+    Row &row = readme.add(highlights);
+    row.format().align(Align::center).hide_border_top();
+  }
+
+  Table empty_row;
+  empty_row.format().hide_border();
+
+  {
+    Row &row = readme.add(empty_row);
+    row.format().hide_border_left().hide_border_right();
+  }
+
+  {
+    Row &row = readme.add("Easily format and align content within cells");
+    row.format().align(Align::center);
+
+    row.format().color(Color::cyan).styles(Style::underline).border_color(Color::green).border_top_padding(0).border_bottom_padding(0);
+  }
+
+  {
+    Table format;
+    {
+      Row &row = format.add("Horizontal Alignment", "Left aligned", "Center aligned", "Right aligned");
+      row.format().align(Align::center);
+      row[0].format().color(Color::green); //.column_separator(":")
+    }
+
+    {
+      Row &row =
+          format.add("Word-Wrapping algorithm taking shamelessly from StackOverflow", "Long sentences automatically word-wrap based on the width of the column",
+                     "Word-wrapping also plays nicely with alignment rules. For instance, this cell is center "
+                     "aligned.",
+                     "Enforce \ncustom word-wrapping \nby embedding '\\n' \ncharacters in your cell\n content.");
+      format.column(1).format().width(25).align(Align::left);
+      format.column(2).format().width(25).align(Align::center);
+      format.column(3).format().width(25).align(Align::right);
+
+      row[0].format().align(Align::center);
+      row[2].format().align(Align::center);
+      row[3].format().align(Align::right);
+    }
+
+    format.column(0).format().width(23);
+    format.column(1).format().border_left(":");
+
+    Row &row = readme.add(format);
+    row.format().hide_border_top().border_top_padding(0);
+  }
+
+  {
+    Row &row = readme.add(empty_row);
+    row.format().hide_border_left().hide_border_right();
+  }
+
+  {
+    // clang-format off
+        Table embedded_table(
+            "You can even\n embed tables...",
+            Table(
+                "within tables",
+                Table(
+                    "within tables",
+                    Table(
+                        "within tables",
+                        Table("within tables ...")
+                    )
+                )
+            )
+        );
+        embedded_table.format().align(Align::center);
+    // clang-format on
+
+    {
+      Row &row = readme.add("Nested Representations");
+      row.format().align(Align::center);
+    }
+
+    Row &row = readme.add(embedded_table);
+    row.format().hide_border_top().border_color(Color::white).color(Color::yellow);
+  }
+
+  {
+    Row &row = readme.add("ᚠ ᚡ ᚢ ᚣ ᚤ ᚥ ᚦ ᚧ ᚨ ᚩ ᚪ ᚫ ᚬ ᚭ ᚮ ᚯ ᚰ ᚱ ᚲ ᚳ ᚴ ᚵ ᚶ ᚷ ᚸ ᚹ ᚺ ᚻ ᚼ ᚽ ᚾ ᚿ ᛀ ᛁ ᛂ ᛃ ᛄ ᛅ ᛆ ᛇ "
+                          "ᛈ ᛉ ᛊ ᛋ ᛌ ᛍ ᛎ ᛏ ᛐ ᛑ ᛒ ᛓ");
+    row.format().background_color(Color::red).hide_border_top().multi_bytes_character(true);
+  }
+
+  readme.format().border_color(Color::yellow).align(Align::center);
+  return readme;
+}
+
+Table summary_chart()
+{
+  Table chart;
+
+  // row 0 - 9
+  for (size_t i = 0; i < 9; ++i) {
+    std::vector<std::string> values;
+    values.push_back(to_string(90 - i * 10));
+    for (size_t j = 0; j <= 50; ++j) {
+      values.push_back(" ");
+    }
+
+    chart.add_multiple(values);
+  }
+
+  // row 10
+  {
+    std::vector<std::string> values;
+    for (int i = 0; i <= 12; ++i) {
+      if ((i + 1) % 4 == 0) {
+        values.push_back(to_string(i + 1));
+      } else {
+        values.push_back(" ");
+      }
+    }
+    chart.add_multiple(values);
+  }
+  chart.add();
+  chart.format().color(Color::white).border_left_padding(0).border_right_padding(0).hide_border();
+  chart.column(0).format().border_left_padding(1).border_right_padding(1).border_left(" ");
+
+  // chart.format().width(2).hide_border();
+  for (size_t i = 0; i <= 18; ++i) {
+    chart.column(i).format().width(2);
+  }
+
+  chart.column(2).format().border_color(Color::white).border_left("|").border_top("-");
+  chart.column(2).format(7, 8).background_color(Color::red);
+  chart.column(3).format(5, 8).background_color(Color::yellow);
+  chart.column(6).format(5, 8).background_color(Color::red);
+  chart.column(7).format(4, 8).background_color(Color::yellow);
+  chart.column(10).format(3, 8).background_color(Color::red);
+  chart.column(11).format(1, 8).background_color(Color::yellow);
+
+  chart[2][15].format().background_color(Color::red);
+  chart[2][16].set("Batch 1");
+
+  chart.column(16).format().border_left_padding(1).width(20);
+
+  chart[4][15].format().background_color(Color::yellow);
+  chart[4][16].set("Batch 2");
+
+  chart.column(17).format().width(50);
+
+  chart[4][17].set("Cells, rows, and columns");
+  chart[5][17].set("can be independently formatted.");
+  chart[7][17].set("This cell is green and italic");
+  chart[7][17].format().color(Color::green).styles(Style::italic);
+
+  chart[8][17].set("This one's yellow and right-aligned");
+  chart[8][17].format().color(Color::yellow).align(Align::right);
+
+  chart[9][17].set("This one's on 🔥🔥🔥");
+
+  chart.format().align(Align::center);
+  chart.column(0).format().border_left_padding(1).border_right_padding(1).border_left(" ");
+
+  return chart;
+}
+
+Table summary_legend()
+{
+  Table legend;
+  legend.add("Batch 1", "10", "40", "50", "20", "10", "50");
+  legend.add("Batch 2", "30", "60", "(70)", "50", "40", "30");
+
+  legend[0].format().align(Align::center);
+  legend[1].format().align(Align::center);
+
+  legend.column(0).format().align(Align::right).color(Color::green).background_color(Color::black);
+
+  legend.column(2).format().color(Color::white).background_color(Color::red);
+
+  legend[1][3].format().styles(Style::italic).color(Color::yellow);
+
+  return legend;
+}
+
+Table class_diagram()
+{
+  Table class_diagram;
+
+  // Animal class
+  {
+    Table animal;
+    animal.add("Animal");
+    animal[0].format().align(Align::center);
+
+    // Animal properties nested table
+    {
+      Table animal_properties;
+      animal_properties.add("+age: Int");
+      animal_properties.add("+gender: String");
+      animal_properties.format().width(20);
+      animal_properties[0].format().hide_border_bottom();
+
+      animal.add(animal_properties);
+    }
+
+    // Animal methods nested table
+    {
+      Table animal_methods;
+      animal_methods.add("+isMammal()");
+      animal_methods.add("+mate()");
+      animal_methods.format().width(20);
+      animal_methods[0].format().hide_border_bottom();
+
+      animal.add(animal_methods);
+    }
+    animal[1].format().hide_border_bottom();
+
+    class_diagram.add(animal);
+  }
+
+  // Add rows in the class diagram for the up-facing arrow
+  // THanks to center alignment, these will align just fine
+  class_diagram.add("▲");
+  class_diagram[1][0].format().hide_border_bottom().multi_bytes_character(true);
+  class_diagram.add("|");
+  class_diagram[2].format().hide_border_bottom();
+  class_diagram.add("|");
+  class_diagram[3].format().hide_border_bottom();
+
+  // Duck class
+  {
+    Table duck;
+    duck.add("Duck");
+
+    // Duck proeperties nested table
+    {
+      Table duck_properties;
+      duck_properties.add("+beakColor: String = \"yellow\"");
+      duck_properties.format().width(40);
+
+      duck.add(duck_properties);
+    }
+
+    // Duck methods nested table
+    {
+      Table duck_methods;
+      duck_methods.add("+swim()");
+      duck_methods.add("+quack()");
+      duck_methods.format().width(40);
+      duck_methods[0].format().hide_border_bottom();
+
+      duck.add(duck_methods);
+    }
+
+    duck[0].format().align(Align::center);
+    duck[1].format().hide_border_bottom();
+
+    class_diagram.add(duck);
+  }
+
+  // Global styling
+  class_diagram.format().styles(Style::bold).align(Align::center).width(60).hide_border();
+
+  return class_diagram;
+}
+
+Table runic()
+{
+  Table table;
+
+  /*
+      This is a story of a bear and
+      a wolf, who wandered the
+      realms nine to fulfill a promise
+      to one before; they walk the
+      twilight path, destined to
+      discower the truth
+      that is to come.
+  */
+  table.add("ᛏᚺᛁᛊ ᛁᛊ ᚨ ᛊᛏᛟᚱy ᛟᚠᚨ ᛒᛖᚨᚱ ᚨᚾᛞ\n"
+            "ᚨ ᚹᛟᛚᚠ, ᚹᚺᛟ ᚹᚨᚾᛞᛖᚱᛖᛞ ᛏᚺᛖ\n"
+            "ᚱᛖᚨᛚᛗᛊ ᚾᛁᚾᛖ ᛏᛟ ᚠᚢᛚᚠᛁᛚᛚ ᚨ ᛈᚱᛟᛗᛁᛊᛖ\n"
+            "ᛏᛟ ᛟᚾᛖ ᛒᛖᚠᛟᚱᛖ; ᛏᚺᛖy ᚹᚨᛚᚲ ᛏᚺᛖ\n"
+            "ᛏᚹᛁᛚᛁᚷᚺᛏ ᛈᚨᛏᚺ, ᛞᛖᛊᛏᛁᚾᛖᛞ ᛏᛟ\n"
+            "ᛞᛁᛊcᛟᚹᛖᚱ ᛏᚺᛖ ᛏᚱᚢᛏᚺ\nᛏᚺᚨᛏ ᛁᛊ ᛏᛟ cᛟᛗᛖ.");
+
+  table[0][0]
+      .format()
+      .multi_bytes_character(true)
+      // Font styling
+      .styles(Style::bold, Style::faint)
+      .align(Align::center)
+      .color(Color::red)
+      .background_color(Color::yellow)
+      // Corners
+      .corner_top_left("ᛰ")
+      .corner_top_right("ᛯ")
+      .corner_bottom_left("ᛮ")
+      .corner_bottom_right("ᛸ")
+      .corner_top_left_color(Color::cyan)
+      .corner_top_right_color(Color::yellow)
+      .corner_bottom_left_color(Color::green)
+      .corner_bottom_right_color(Color::red)
+      // Borders
+      .border_top("ᛜ")
+      .border_bottom("ᛜ")
+      .border_left("ᚿ")
+      .border_right("ᛆ")
+      .border_left_color(Color::yellow)
+      .border_right_color(Color::green)
+      .border_top_color(Color::cyan)
+      .border_bottom_color(Color::red);
+
+  return table;
+}
+
+Table unicode()
+{
+  Table table;
+
+  table.add("English", "I love you");
+  table.add("French", "Je t’aime");
+  table.add("Spanish", "Te amo");
+  table.add("German", "Ich liebe Dich");
+  table.add("Mandarin Chinese", "我爱你");
+  table.add("Japanese", "愛してる");
+  table.add("Korean", "사랑해 (Saranghae)");
+  table.add("Greek", "Σ΄αγαπώ (Se agapo)");
+  table.add("Italian", "Ti amo");
+  table.add("Russian", "Я тебя люблю (Ya tebya liubliu)");
+  table.add("Hebrew", "אני אוהב אותך (Ani ohev otakh)");
+
+  // Column 1 is using mult-byte characters
+  table.column(1).format().multi_bytes_character(true);
+  table.format().corner("♥").styles(Style::bold).corner_color(Color::magenta).border_color(Color::magenta);
+
+  return table;
+}
+
+std::vector<std::pair<std::string, Table>> tables()
+{
+  return {
+      {"mario", mario()},
+      {"summary", summary()},
+      {"summary-chart", summary_chart()},
+      {"summary-legend", summary_legend()},
+      {"class-diagram", class_diagram()},
+      {"runic", runic()},
+      {"unicode", unicode()},
+  };
+}
+} // namespace samples
@@ -0,0 +1,50 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "tabulate.h"
+using namespace tabulate;
+
+namespace samples
+{
+/** @brief Builds the pixel art of samples/mario.cc */
+Table mario();
+
+/** @brief Builds the feature summary of samples/summary.cc */
+Table summary();
+
+/** @brief Builds the bar chart of samples/summary.cc */
+Table summary_chart();
+
+/** @brief Builds the legend of the bar chart of samples/summary.cc */
+Table summary_legend();
+
+/** @brief Builds the nested tables of samples/class-diagram.cc */
+Table class_diagram();
+
+/** @brief Builds the runic poem of samples/runic.cc */
+Table runic();
+
+/** @brief Builds the translations of samples/unicode.cc */
+Table unicode();
+
+/**
+ * @brief Builds all the tables above
+ * @return The tables by name, in a fixed order
+ */
+std::vector<std::pair<std::string, Table>> tables();
+} // namespace samples
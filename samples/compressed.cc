@@ -0,0 +1,168 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstdio>
+#include <iostream>
+#include "tabulate.h"
+#if defined(TABULATE_HAS_ZLIB)
+#  include <zlib.h>
+#endif
+#if defined(TABULATE_HAS_ZSTD)
+#  include <zstd.h>
+#endif
+using namespace tabulate;
+
+#if defined(TABULATE_HAS_ZLIB)
+static std::string gunzip(const std::string &compressed)
+{
+  z_stream stream = {};
+  inflateInit2(&stream, 15 + 16);
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed.data()));
+  stream.avail_in = static_cast<uInt>(compressed.size());
+
+  std::string plain;
+  char buffer[16384];
+  int rc = Z_OK;
+  while (rc == Z_OK) {
+    stream.next_out = reinterpret_cast<Bytef *>(buffer);
+    stream.avail_out = sizeof(buffer);
+    rc = inflate(&stream, Z_NO_FLUSH);
+    plain.append(buffer, sizeof(buffer) - stream.avail_out);
+  }
+  inflateEnd(&stream);
+  return rc == Z_STREAM_END ? plain : std::string();
+}
+
+static std::string read_all(FILE *file)
+{
+  std::string content;
+  std::rewind(file);
+  char buffer[65536];
+  for (size_t size; (size = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) {
+    content.append(buffer, size);
+  }
+  return content;
+}
+#endif
+
+#if defined(TABULATE_HAS_ZSTD)
+static std::string unzstd(const std::string &compressed)
+{
+  ZSTD_DCtx *context = ZSTD_createDCtx();
+  ZSTD_inBuffer in = {compressed.data(), compressed.size(), 0};
+
+  std::string plain;
+  std::vector<char> buffer(ZSTD_DStreamOutSize());
+  size_t rc = 1;
+  while (rc != 0 && !ZSTD_isError(rc) && in.pos < in.size) {
+    ZSTD_outBuffer out = {buffer.data(), buffer.size(), 0};
+    rc = ZSTD_decompressStream(context, &out, &in);
+    plain.append(buffer.data(), out.pos);
+  }
+  ZSTD_freeDCtx(context);
+  return rc == 0 ? plain : std::string();
+}
+#endif
+
+int main()
+{
+#if defined(TABULATE_HAS_ZLIB) || defined(TABULATE_HAS_ZSTD)
+  Table metrics;
+  metrics.add("Host", "Requests", "Errors", "Latency");
+  metrics[0].format().color(Color::yellow).styles(Style::bold);
+  for (size_t i = 0; i < 1000; i++) {
+    metrics.add("node-" + to_string(i % 40), to_string(i * 131 % 9973), to_string(i % 7), to_string(i % 250) + " ms");
+  }
+  bool ok = true;
+#endif
+
+#if defined(TABULATE_HAS_ZLIB)
+  // rows are compressed as they are rendered, the plain text is never held in full
+  std::string xterm, markdown;
+  {
+    StringSink out(xterm);
+    GzipSink gzip(out);
+    metrics.xterm(gzip);
+  }
+  {
+    StringSink out(markdown);
+    GzipSink gzip(out, 9);
+    metrics.markdown(gzip);
+    gzip.finish();
+    ok = ok && gzip.error() == 0;
+  }
+
+  std::string plain = metrics.xterm();
+  std::cout << "xterm " << plain.size() << " bytes, gzip " << xterm.size() << " bytes" << std::endl;
+  std::cout << "markdown " << metrics.markdown().size() << " bytes, gzip " << markdown.size() << " bytes" << std::endl;
+  ok = ok && gunzip(xterm) == plain && gunzip(markdown) == metrics.markdown();
+
+  // digests barely compress, most of the compressed export goes to the file before finish()
+  Table digests;
+  digests.add("Object", "Digest");
+  unsigned long long seed = 88172645463325252ull;
+  for (size_t i = 0; i < 2000; i++) {
+    std::string digest;
+    for (int k = 0; k < 16; k++) {
+      seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+      char hex[17];
+      std::snprintf(hex, sizeof(hex), "%016llx", seed);
+      digest += hex;
+    }
+    digests.add("object-" + to_string(i), digest);
+  }
+
+  FILE *file = std::tmpfile();
+  size_t on_disk;
+  {
+    FileSink out(fileno(file));
+    GzipSink gzip(out);
+    digests.xterm(gzip);
+    std::fseek(file, 0, SEEK_END);
+    on_disk = static_cast<size_t>(std::ftell(file));
+    gzip.finish();
+    ok = ok && gzip.error() == 0 && out.error() == 0;
+  }
+  std::string compressed = read_all(file);
+  std::fclose(file);
+
+  // held at most: a block of input in GzipSink, what deflate keeps back, and 64 KiB in FileSink
+  std::cout << "digests gzip " << compressed.size() << " bytes, " << on_disk << " on disk before finish()" << std::endl;
+  ok = ok && on_disk > 0 && on_disk + 128 * 1024 >= compressed.size();
+  ok = ok && gunzip(compressed) == digests.xterm();
+#endif
+
+#if defined(TABULATE_HAS_ZSTD)
+  std::string zstd;
+  {
+    StringSink out(zstd);
+    ZstdSink compressor(out);
+    metrics.xterm(compressor);
+    compressor.finish();
+    ok = ok && compressor.error() == 0;
+  }
+  std::cout << "xterm " << metrics.xterm().size() << " bytes, zstd " << zstd.size() << " bytes" << std::endl;
+  ok = ok && unzstd(zstd) == metrics.xterm();
+#endif
+
+#if defined(TABULATE_HAS_ZLIB) || defined(TABULATE_HAS_ZSTD)
+  return ok ? 0 : 1;
+#else
+  std::cout << "tabulate is built without zlib and libzstd" << std::endl;
+  return 0;
+#endif
+}
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include "tabulate.h"
+using namespace tabulate;
+
+static std::string read_file(const std::string &path)
+{
+  std::ifstream in(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+int main()
+{
+  Table ledger;
+  ledger.set_title("Ledger");
+  ledger.add("Entry", "Account", "Debit", "Credit", "Memo");
+  for (size_t i = 0; i < 1000; i++) {
+    ledger.add(i, "account-" + to_string(i % 17), to_string(i * 13 % 500), to_string(i * 7 % 300),
+               i % 10 == 0 ? "quarterly adjustment, reviewed by the auditors" : "");
+  }
+  ledger[0].format().color(Color::yellow).styles(Style::bold);
+  ledger.column(4).format().width(24);
+  ledger.column(2).format().align(Align::right);
+
+  RenderProfile profile;
+  profile.color = ColorMode::truecolor;
+
+  // rows are rendered into the mapped file by four threads
+  const std::string path = "tabulate-export.txt";
+  bool exported = ledger.export_to_file(path, Exporter::xterm, profile, 4);
+  bool xterm = exported && read_file(path) == ledger.xterm(profile);
+  bool markdown = ledger.export_to_file(path, Exporter::markdown) && read_file(path) == ledger.markdown();
+  bool latex = ledger.export_to_file(path, Exporter::latex) && read_file(path) == ledger.latex();
+  std::remove(path.c_str());
+
+  Table result;
+  result.add("Exporter", "Bytes", "Matches");
+  result.add("xterm", ledger.rendered_size(Exporter::xterm, profile), xterm ? "yes" : "no");
+  result.add("markdown", ledger.rendered_size(Exporter::markdown), markdown ? "yes" : "no");
+  result.add("latex", ledger.rendered_size(Exporter::latex), latex ? "yes" : "no");
+  std::cout << result.xterm() << std::endl;
+
+  bool refused = !ledger.export_to_file("no-such-directory/ledger.txt");
+  return xterm && markdown && latex && refused ? 0 : 1;
+}
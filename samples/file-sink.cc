@@ -0,0 +1,70 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cstdio>
+#include <iostream>
+#include "tabulate.h"
+using namespace tabulate;
+
+int main()
+{
+  Table inventory;
+  inventory.add("SKU", "Item", "Stock", "Warehouse");
+  for (size_t i = 0; i < 1000; i++) {
+    inventory.add("SKU-" + to_string(100000 + i), "item number " + to_string(i), i * 37 % 1000, i % 3 == 0 ? "north" : "south");
+  }
+  inventory[0].format().color(Color::yellow).styles(Style::bold);
+  inventory.column(2).format().align(Align::right);
+
+  // the lines go to the file as they are, gathered into writev() batches
+  FILE *file = std::tmpfile();
+  bool bounded;
+  {
+    FileSink sink(fileno(file));
+    inventory.xterm(sink);
+    sink.write(NEWLINE);
+
+    // before the last flush, at most a batch of 64 KiB is still held
+    size_t rendered = inventory.rendered_size(Exporter::xterm) + NEWLINE.size();
+    std::fseek(file, 0, SEEK_END);
+    size_t on_disk = static_cast<size_t>(std::ftell(file));
+    bounded = on_disk > 0 && on_disk + 64 * 1024 >= rendered;
+    std::cout << "rendered " << rendered << " bytes, " << on_disk << " on disk before the last flush" << std::endl;
+  }
+
+  std::string written;
+  std::rewind(file);
+  char buffer[65536];
+  for (size_t size; (size = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) {
+    written.append(buffer, size);
+  }
+  std::fclose(file);
+
+  // to the terminal too
+  Table head;
+  head.add("Rendered", "Bytes");
+  head.add("inventory", written.size());
+  FileSink out(1);
+  head.xterm(out);
+  out.write(NEWLINE);
+
+  out.flush();
+
+  std::string expected = inventory.xterm();
+  expected += NEWLINE;
+  return written == expected && bounded && out.error() == 0 ? 0 : 1;
+}
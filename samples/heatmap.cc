@@ -0,0 +1,79 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include <limits>
+#include "tabulate.h"
+using namespace tabulate;
+
+int main()
+{
+  Table latency;
+  latency.add("Endpoint", "p50 (ms)", "p99 (ms)", "Requests");
+  latency.add("/login", "12", "48", "1200");
+  latency.add("/search", "35", "410", "98000");
+  latency.add("/checkout", "88", "1250", "430");
+  latency.add("/health", "1", "3", "2");
+  latency.add("/export", "240", "5200", "n/a");
+  latency[0].format().styles(Style::bold);
+
+  // green to yellow to red on the latency columns, requests on a log scale
+  ColorMap heat({0x2E7D32, 0xF9A825, 0xC62828});
+  latency.colormap(1, heat);
+  latency.colormap(2, ColorMap({0x2E7D32, 0xF9A825, 0xC62828}).range(0, 1000));
+  latency.colormap(3, ColorMap({0x263238, 0x0277BD}, ColorMap::Scale::log));
+  latency.column(1).format().align(Align::right);
+  latency.column(2).format().align(Align::right);
+  latency.column(3).format().align(Align::right);
+
+  std::cout << latency.xterm() << std::endl;
+
+  // a batch of several blocks maps like value by value, on both scales
+  std::vector<double> values;
+  for (int i = -100; i <= 700; i++) {
+    values.push_back(i * 0.6);
+  }
+  values.push_back(std::numeric_limits<double>::quiet_NaN());
+  std::vector<TrueColor> colors(values.size());
+  ColorMap ranged = ColorMap({Color::blue, Color::white, Color::red}).range(0, 370);
+  ColorMap logarithmic = ColorMap({0x263238, 0x0277BD}, ColorMap::Scale::log).range(1, 200);
+  for (const ColorMap *colormap : {&ranged, &logarithmic}) {
+    colormap->map(values.data(), values.size(), colors.data());
+    for (size_t i = 0; i < values.size(); i++) {
+      if (colors[i].hex != (*colormap)(values[i]).hex) {
+        return 1;
+      }
+    }
+  }
+
+  // without a range a single value is ranged to itself
+  ColorMap unranged({Color::green, Color::red}, ColorMap::Scale::log);
+  for (double value : {42.0, 0.0}) {
+    TrueColor color;
+    unranged.map(&value, 1, &color);
+    if (color.hex != unranged(value).hex || color.none() != unranged(value).none()) {
+      return 1;
+    }
+  }
+  ranged.map(values.data(), values.size(), colors.data());
+
+  // the stops are hit exactly, the middle of a segment is TrueColor::merge
+  TrueColor blue(Color::blue), white(Color::white);
+  bool exact = ranged(0).hex == blue.hex && ranged(370).hex == TrueColor(Color::red).hex && ranged(185).hex == white.hex;
+  bool merged = ranged(92.5).hex == TrueColor::merge(blue, white).hex && TrueColor::merge(blue, white, 0.5).hex == TrueColor::merge(blue, white).hex;
+
+  return exact && merged && colors.back().none() ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <iostream>
+#include "tabulate.h"
+using namespace tabulate;
+
+// helpers of the program named like internals of tabulate, which stay out of its namespace
+static std::string strip_escapes(std::string text)
+{
+  std::string plain;
+  for (size_t i = 0; i < text.size(); i++) {
+    if (text[i] == '\033') {
+      while (i < text.size() && text[i] != 'm') {
+        i++;
+      }
+    } else {
+      plain += text[i];
+    }
+  }
+  return plain;
+}
+
+static double value_of(const std::string &text)
+{
+  return std::stod(text);
+}
+
+static size_t glyph_size(const std::string &text, size_t)
+{
+  return text.size();
+}
+
+int main()
+{
+  Table prices;
+  prices.add("Item", "Price");
+  prices.add("Coffee", "3.5");
+  prices.add("Bagel", "2.25");
+  prices[0].format().color(Color::yellow).styles(Style::bold);
+
+  double total = value_of(prices[1][1].get()) + value_of(prices[2][1].get());
+  prices.add("Total", to_string(total));
+
+  std::string plain = strip_escapes(prices.xterm());
+  std::cout << plain << std::endl;
+
+  return plain.find("5.75") != std::string::npos && glyph_size("Total", 0) == 5 ? 0 : 1;
+}
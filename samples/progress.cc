@@ -0,0 +1,202 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <iostream>
+#include "tabulate.h"
+using namespace tabulate;
+
+// a terminal understanding the cursor moves of the updater and background colors, one glyph per column
+struct Screen {
+  std::vector<std::vector<std::string>> lines{1};
+  size_t line = 0, column = 0;
+  std::string background;
+
+  void select(const std::string &parameters)
+  {
+    std::vector<std::string> codes(1);
+    for (char c : parameters) {
+      if (c == ';' || c == ':') {
+        codes.emplace_back();
+      } else {
+        codes.back() += c;
+      }
+    }
+    for (size_t k = 0; k < codes.size(); k++) {
+      if (codes[k].empty() || codes[k] == "0" || codes[k] == "00" || codes[k] == "49") {
+        background.clear();
+      } else if (codes[k] == "38" || codes[k] == "48") {
+        size_t count = k + 1 < codes.size() && codes[k + 1] == "2" ? 4 : 2;
+        if (codes[k] == "48") {
+          background.clear();
+          for (size_t n = k + 1; n <= k + count && n < codes.size(); n++) {
+            background += codes[n] + ",";
+          }
+        }
+        k += count;
+      } else if (codes[k].size() == 2 && codes[k][0] == '4') {
+        background = codes[k];
+      }
+    }
+  }
+
+  void feed(const std::string &bytes)
+  {
+    for (size_t i = 0; i < bytes.size();) {
+      if (bytes[i] == '\x1b') {
+        size_t end = bytes.find_first_of("ABGm", i);
+        std::string parameters = bytes.substr(i + 2, end - i - 2);
+        if (bytes[end] == 'm') {
+          select(parameters);
+        } else if (bytes[end] == 'A') {
+          line -= std::stoul(parameters);
+        } else if (bytes[end] == 'B') {
+          line += std::stoul(parameters);
+        } else {
+          column = std::stoul(parameters) - 1;
+        }
+        i = end + 1;
+      } else if (bytes[i] == '\n' || bytes[i] == '\r') {
+        line += bytes[i] == '\n' ? 1 : 0;
+        column = 0;
+        lines.resize(std::max(lines.size(), line + 1));
+        i++;
+      } else {
+        size_t size = 1;
+        while (i + size < bytes.size() && (bytes[i + size] & 0xC0) == 0x80) {
+          size++;
+        }
+        lines[line].resize(std::max(lines[line].size(), column + 1));
+        lines[line][column++] = background.empty() ? bytes.substr(i, size) : background + bytes.substr(i, size);
+        i += size;
+      }
+    }
+  }
+};
+
+int main()
+{
+  Table jobs;
+  jobs.add("Job", "Progress", "Done");
+  for (int i = 0; i < 6; i++) {
+    jobs.add("build-" + to_string(i), i * 7, to_string(i * 7) + "%");
+  }
+  jobs[0].format().styles(Style::bold);
+  jobs.column(1).format().width(24).color(Color::green);
+  jobs.progress(1);
+
+  // the table is drawn once, every tick writes only the glyphs that changed
+  RenderProfile profile;
+  profile.no_color = true;
+  std::string output;
+  StringSink sink(output);
+  ProgressUpdater updater(jobs, sink, profile);
+  updater.render();
+
+  Screen screen;
+  screen.feed(output);
+  size_t largest = 0;
+  for (int tick = 1; tick <= 100; tick++) {
+    for (size_t row = 1; row < jobs.size(); row++) {
+      output.clear();
+      updater.set(row, 1, std::min(100.0, (row - 1) * 7 + tick * (row + 1) / 2.0));
+      screen.feed(output);
+      largest = std::max(largest, output.size());
+    }
+  }
+  bool text = !updater.set(1, 2, 100);
+
+  // the updated screen is what a new render draws
+  std::string fresh;
+  StringSink again(fresh);
+  ProgressUpdater(jobs, again, profile).render();
+  Screen expected;
+  expected.feed(fresh);
+
+  for (auto const &line : screen.lines) {
+    for (auto const &glyph : line) {
+      std::cout << glyph;
+    }
+    std::cout << std::endl;
+  }
+  std::cout << "largest update: " << largest << " bytes, table: " << fresh.size() << " bytes" << std::endl;
+
+  // a colormap ranged to the values recolors the whole column when one of them changes
+  Table heat;
+  heat.add("Shard", "Load");
+  for (int i = 0; i < 4; i++) {
+    heat.add("shard-" + to_string(i), 20 + i * 10);
+  }
+  heat.column(0).format().border_top_padding(1);
+  heat.column(1).format().width(12).border_bottom_padding(1);
+  heat.progress(1);
+  heat.colormap(1, ColorMap({0x2E7D32, 0xF9A825, 0xC62828}));
+
+  RenderProfile colors;
+  colors.color = ColorMode::truecolor;
+  colors.no_color = false;
+  colors.isatty = true;
+  std::string drawn;
+  StringSink colored(drawn);
+  ProgressUpdater meter(heat, colored, colors);
+  meter.render();
+  Screen heated;
+  heated.feed(drawn);
+  for (double load : {90.0, 5.0, 55.0}) {
+    drawn.clear();
+    meter.set(2, 1, load);
+    heated.feed(drawn);
+  }
+
+  std::string redrawn;
+  StringSink once(redrawn);
+  ProgressUpdater(heat, once, colors).render();
+  Screen recolored;
+  recolored.feed(redrawn);
+
+  // bars below a title and beside wrapped cells, with ASCII borders, are found where they are drawn
+  Table tasks;
+  tasks.set_title("nightly");
+  tasks.add("Task", "Progress");
+  tasks.add("fetch the sources of every dependency", 10);
+  tasks.add("test", 60);
+  tasks.column(0).format().width(14);
+  tasks.column(1).format().width(10).align(Align::right);
+  tasks.progress(1);
+
+  RenderProfile ascii = profile;
+  ascii.unicode = false;
+  std::string ticked;
+  StringSink ticks(ticked);
+  ProgressUpdater nightly(tasks, ticks, ascii);
+  nightly.render();
+  Screen moved;
+  moved.feed(ticked);
+  for (double done : {35.0, 100.0}) {
+    ticked.clear();
+    nightly.set(1, 1, done);
+    nightly.set(2, 1, done / 2);
+    moved.feed(ticked);
+  }
+
+  std::string settled;
+  StringSink last(settled);
+  ProgressUpdater(tasks, last, ascii).render();
+  Screen rendered;
+  rendered.feed(settled);
+
+  return text && screen.lines == expected.lines && largest < 32 && heated.lines == recolored.lines && moved.lines == rendered.lines ? 0 : 1;
+}
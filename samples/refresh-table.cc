@@ -21,6 +21,7 @@
 #include <unistd.h>
 #include <sys/select.h>
 
+#include <iostream>
 #include "tabulate.h"
 using namespace tabulate;
 
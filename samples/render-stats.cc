@@ -0,0 +1,112 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include "tabulate.h"
+using namespace tabulate;
+
+void print(const std::string &name, const RenderStats &stats)
+{
+  Table table;
+  table.add("Exporter", "Rows", "Cells", "Widths", "Bytes Measured", "Wraps", "SGRs", "Output", "Layout (ns)", "Dump (ns)", "Join (ns)");
+  table.add(name, stats.rows, stats.cells, stats.width_calls, stats.width_bytes, stats.wraps, stats.sgrs, stats.output_bytes, stats.layout_ns, stats.dump_ns,
+            stats.join_ns);
+  table[0].format().styles(Style::bold);
+  std::cout << table.xterm() << std::endl;
+}
+
+int main()
+{
+  Table movies;
+  movies.add("S/N", "Movie Name", "Director", "Estimated Budget", "Release Date");
+  movies.add("tt1979376", "Toy Story 4", "Josh Cooley", 200000000, "21 June 2019");
+  movies.add("tt3263904", "Sully", "Clint Eastwood", 60000000, "9 September 2016");
+  movies.add("tt1535109", "Captain Phillips", "Paul Greengrass", 55000000, " 11 October 2013");
+  movies[0].format().color(Color::yellow).styles(Style::bold);
+  movies.column(3).format().align(Align::right);
+
+  if (!RenderStats::enabled()) {
+    std::cout << "render statistics are disabled, configure with -DTABULATE_RENDER_STATS=ON" << std::endl;
+  }
+
+  bool consistent = true;
+  {
+    RenderStats stats;
+    std::string exported;
+    {
+      RenderStatsScope scope(stats);
+      exported = movies.xterm(ColorMode::truecolor);
+    }
+    print("xterm", stats);
+    if (RenderStats::enabled()) {
+      consistent = consistent && stats.rows == movies.size() && stats.cells == 5 * movies.size() && stats.output_bytes == exported.size() && stats.sgrs > 0;
+    }
+  }
+
+  {
+    RenderStats stats;
+    std::string exported;
+    {
+      RenderStatsScope scope(stats);
+      exported = movies.markdown();
+    }
+    print("markdown", stats);
+    if (RenderStats::enabled()) {
+      consistent = consistent && stats.rows == movies.size() && stats.output_bytes == exported.size();
+    }
+  }
+
+  // column widths are fitted as rows are added
+  {
+    RenderStats stats;
+    Table fitted;
+    {
+      RenderStatsScope scope(stats);
+      for (size_t i = 0; i < movies.size(); i++) {
+        fitted.add(movies[i][0].get(), movies[i][1].get(), movies[i][2].get(), movies[i][3].get(), movies[i][4].get());
+      }
+    }
+    print("add", stats);
+    if (RenderStats::enabled()) {
+      consistent = consistent && stats.layout_ns > 0 && stats.width_calls > 0 && stats.dump_ns == 0;
+    }
+  }
+
+  // the workers of a batch add up into the statistics of the caller
+  {
+    std::vector<Table> copies(16, movies);
+    std::string report;
+    StringSink sink(report);
+    std::vector<RenderJob> jobs;
+    for (auto const &table : copies) {
+      jobs.push_back({&table, &sink});
+    }
+
+    RenderStats stats;
+    {
+      RenderStatsScope scope(stats);
+      render_batch(jobs, 4);
+    }
+    print("batch", stats);
+    if (RenderStats::enabled()) {
+      consistent = consistent && stats.rows == copies.size() * movies.size() && stats.output_bytes == report.size();
+    } else {
+      consistent = consistent && stats.rows == 0 && stats.output_bytes == 0;
+    }
+  }
+
+  return consistent ? 0 : 1;
+}
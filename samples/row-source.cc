@@ -0,0 +1,130 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include <sstream>
+#include "tabulate.h"
+using namespace tabulate;
+
+class CountingSink : public Sink {
+ public:
+  using Sink::write;
+  void write(const char *, size_t size) override
+  {
+    bytes += size;
+  }
+
+  size_t bytes = 0;
+};
+
+int main()
+{
+  // the table declares the columns, rows are pulled while rendering
+  Table schema;
+  schema.set_title("Orders");
+  schema.add("Order", "Customer", "Amount");
+  schema[0].format().color(Color::yellow).styles(Style::bold);
+  schema.column(0).format().width(10);
+  schema.column(1).format().width(16);
+  schema.column(2).format().width(12).align(Align::right);
+
+  size_t produced = 0;
+  FunctionRowSource orders([&](Row &row) {
+    if (produced == 5) {
+      return false;
+    }
+    row.add(100000 + produced, "customer-" + to_string(produced * 37 % 101), to_string(produced * 19.5));
+    produced++;
+    return true;
+  });
+
+  StreamSink out(std::cout);
+  schema.xterm(orders, out);
+  out.write("\n");
+
+  // widths estimated from a sample of the rows
+  std::vector<std::vector<std::string>> values = {
+      {"Mercury", "0.39 AU"},
+      {"Venus", "0.72 AU"},
+      {"Earth", "1 AU"},
+      {"Jupiter, the largest planet of the solar system", "5.2 AU"},
+  };
+  Table planets;
+  planets.add("Planet", "Distance");
+  RangeRowSource<std::vector<std::vector<std::string>>::const_iterator> source(values.begin(), values.end());
+  planets.xterm(source, out, 2);
+  out.write("\n");
+  out.flush();
+
+  // streaming matches the materialized table
+  Table materialized;
+  materialized.add("Planet", "Distance");
+  for (auto const &row : values) {
+    materialized.add_multiple(row);
+  }
+  std::string expected = materialized.xterm(), streamed;
+  StringSink sink(streamed);
+  RangeRowSource<std::vector<std::vector<std::string>>::const_iterator> again(values.begin(), values.end());
+  planets.xterm(again, sink, values.size());
+
+  // without a header, the first row sizes the columns
+  Table headless, reference;
+  std::vector<std::vector<std::string>> widest = {{"Ganymede", "1070 km/s"}, {"Io", "17 km/s"}, {"Europa", "13 km/s"}};
+  for (auto const &row : widest) {
+    reference.add_multiple(row);
+  }
+  std::string unsized, sized = reference.xterm();
+  StringSink unsized_sink(unsized);
+  RangeRowSource<std::vector<std::vector<std::string>>::const_iterator> moons(widest.begin(), widest.end());
+  headless.xterm(moons, unsized_sink, 0);
+
+  // every row of the table is a header row, only the body rows are colored
+  Table loads;
+  loads.add("Host", "Load");
+  loads.add("", "5");
+  loads.colormap(1, ColorMap({0x000000, 0xFFFFFF}).range(0, 10));
+  RenderProfile truecolor;
+  truecolor.color = ColorMode::truecolor;
+  truecolor.no_color = false;
+  truecolor.isatty = true;
+  std::vector<std::vector<std::string>> hosts = {{"db", "1"}, {"web", "4"}, {"mq", "9"}};
+  std::string colored;
+  StringSink colored_sink(colored);
+  RangeRowSource<std::vector<std::vector<std::string>>::const_iterator> load(hosts.begin(), hosts.end());
+  loads.xterm(load, colored_sink, 0, truecolor);
+  size_t colored_lines = 0;
+  std::istringstream lines(colored);
+  for (std::string line; std::getline(lines, line);) {
+    colored_lines += line.find("48:2:") != std::string::npos ? 1 : 0;
+  }
+  std::cout << colored << std::endl;
+
+  // a long stream renders in bounded memory
+  size_t count = 0;
+  FunctionRowSource cursor([&](Row &row) {
+    if (count == 20000) {
+      return false;
+    }
+    row.add(count, "row " + to_string(count), count * 3);
+    count++;
+    return true;
+  });
+  CountingSink counter;
+  schema.xterm(cursor, counter);
+  std::cout << "rendered " << count << " rows into " << counter.bytes << " bytes" << std::endl;
+
+  return expected == streamed && sized == unsized && colored_lines == hosts.size() ? 0 : 1;
+}
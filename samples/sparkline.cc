@@ -0,0 +1,51 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cmath>
+#include <iostream>
+#include "tabulate.h"
+using namespace tabulate;
+
+int main()
+{
+  // one cell per metric, two samples per character
+  std::vector<std::vector<double>> series(3, std::vector<double>(60));
+  for (size_t i = 0; i < 60; i++) {
+    series[0][i] = 50 + 40 * std::sin(i / 6.0);
+    series[1][i] = 20 + i % 15 * 4;
+    series[2][i] = i < 30 ? i : 60 - i;
+  }
+
+  Table dashboard;
+  dashboard.add("Metric", "Last hour", "Now");
+  dashboard.add("CPU %", Sparkline(series[0]), to_string(std::lround(series[0].back())));
+  dashboard.add("Connections", Sparkline(series[1], symbols::GraphStyle::block_up), to_string(series[1].back()));
+  dashboard.add("Queue depth", Sparkline(series[2], symbols::GraphStyle::braille_up, 3), to_string(series[2].back()));
+  dashboard.add("Latency (fixed range)", Sparkline(series[2]).range(0, 100), "");
+  dashboard[0].format().styles(Style::bold);
+  dashboard.column(2).format().align(Align::right);
+
+  std::cout << dashboard.xterm() << std::endl;
+
+  // 60 values fit in 30 characters, whatever the number of lines
+  for (size_t i = 1; i < dashboard.size(); i++) {
+    if (dashboard[i][1].width() != 30) {
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iostream>
+#include "tabulate.h"
+using namespace tabulate;
+
+int main()
+{
+  if (!trace::start("tabulate-trace.json")) {
+    std::cout << "tracing is disabled, configure with -DTABULATE_TRACE=ON" << std::endl;
+    return 0;
+  }
+
+  Table inventory;
+  inventory.set_title("Inventory");
+  inventory.add("Warehouse", "Stock");
+  for (int i = 0; i < 3; i++) {
+    Table stock;
+    stock.add("Item", "Count");
+    stock.add("bolts", 120 * (i + 1));
+    stock.add("nuts", 300 - 40 * i);
+    inventory.add("WH-" + to_string(i), stock);
+  }
+  inventory.column(1).format().align(Align::center);
+
+  std::cout << inventory.xterm() << std::endl;
+  std::cout << inventory.markdown() << std::endl;
+  trace::stop();
+
+  // load tabulate-trace.json into chrome://tracing or https://ui.perfetto.dev
+  std::ifstream in("tabulate-trace.json");
+  std::string trace((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  std::cout << "trace: " << trace.size() << " bytes" << std::endl;
+
+  // workers record into buffers of their own, written in chunks and merged by stop()
+  std::vector<Table> hosts(64);
+  for (size_t i = 0; i < hosts.size(); i++) {
+    hosts[i].add("Host", "Load");
+    for (size_t j = 1; j < 100; j++) {
+      hosts[i].add("node-" + to_string(j), to_string(i * j % 100) + "%");
+    }
+  }
+  std::string report;
+  StringSink sink(report);
+  std::vector<RenderJob> jobs;
+  for (auto const &host : hosts) {
+    jobs.push_back({&host, &sink});
+  }
+  trace::start("tabulate-batch-trace.json");
+  render_batch(jobs, 4);
+  trace::stop();
+
+  std::ifstream batch_in("tabulate-batch-trace.json");
+  std::string batch((std::istreambuf_iterator<char>(batch_in)), std::istreambuf_iterator<char>());
+  size_t dumps = 0;
+  for (size_t pos = 0; (pos = batch.find("\"Row::dump\"", pos)) != std::string::npos; pos++) {
+    dumps++;
+  }
+  std::cout << "batch trace: " << dumps << " row spans" << std::endl;
+
+  bool complete = batch.size() > 3 && batch.compare(batch.size() - 3, 3, "]}\n") == 0 && dumps == hosts.size() * 100;
+  complete = complete && trace.find("\"traceEvents\"") != std::string::npos && trace.find("\"nested table\"") != std::string::npos
+                  && trace.find("\"Row::dump\"") != std::string::npos && trace.find("\"Table::markdown\"") != std::string::npos;
+  return complete ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+/**
+ * Copyright 2022 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <iostream>
+#include "tabulate.h"
+using namespace tabulate;
+
+int main()
+{
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+  // the schema is part of the type, rows are type-checked
+  using Processes = TypedTable<Col<"PID", int, 6, Align::right>, Col<"User", std::string, 10>, Col<"CPU %", double, 6, Align::right>,
+                               Col<"Command", std::string, 24>>;
+  static_assert(Processes::columns == 4 && Processes::content_width == 46);
+
+  Processes processes;
+  processes.add(1, "root", 0.1, "/sbin/init splash");
+  processes.add(811, "postgres", 12.5, "postgres: checkpointer");
+  processes.add(Processes::row_type{4242, "kiran", 97.25, "make -j16 tabulate-all"});
+  processes[0].format().styles(Style::bold);
+  std::cout << processes.xterm() << std::endl;
+
+  // the same table built column by column
+  Table table;
+  table.add("PID", "User", "CPU %", "Command");
+  table.add(1, "root", 0.1, "/sbin/init splash");
+  table.add(811, "postgres", 12.5, "postgres: checkpointer");
+  table.add(4242, "kiran", 97.25, "make -j16 tabulate-all");
+  table[0].format().styles(Style::bold);
+  for (size_t i = 0; i < Processes::columns; ++i) {
+    table.column(i).format().width(Processes::widths[i]);
+  }
+  table.column(0).format().align(Align::right);
+  table.column(2).format().align(Align::right);
+
+  return table.xterm() == processes.xterm() ? 0 : 1;
+#else
+  std::cout << "TypedTable needs C++20" << std::endl;
+  return 0;
+#endif
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <iostream>
 #include "tabulate.h"
 using namespace tabulate;
 
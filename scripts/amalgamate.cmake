@@ -0,0 +1,33 @@
+# Merges tabulate.h and tabulate.cc into one header-only tabulate.h
+#
+#   cmake -DHEADER=tabulate.h -DSOURCE=tabulate.cc -DOUTPUT=single_include/tabulate.h -P scripts/amalgamate.cmake
+#
+# tabulate_fwd.h is read from the directory of HEADER.
+
+if(NOT HEADER OR NOT SOURCE OR NOT OUTPUT)
+  message(FATAL_ERROR "usage: cmake -DHEADER=<tabulate.h> -DSOURCE=<tabulate.cc> -DOUTPUT=<file> -P amalgamate.cmake")
+endif()
+
+get_filename_component(directory "${HEADER}" DIRECTORY)
+file(READ "${HEADER}" header)
+file(READ "${directory}/tabulate_fwd.h" forward)
+file(READ "${SOURCE}" source)
+
+set(include_source "#if defined(TABULATE_HEADER_ONLY)\n#  include \"tabulate.cc\"\n#endif\n")
+string(FIND "${header}" "${include_source}" found)
+if(found EQUAL -1)
+  message(FATAL_ERROR "${HEADER} does not include tabulate.cc in header-only mode")
+endif()
+string(FIND "${source}" "#include \"tabulate.h\"\n" found)
+if(found EQUAL -1)
+  message(FATAL_ERROR "${SOURCE} does not include tabulate.h")
+endif()
+
+# the amalgamated header is always header-only
+string(REPLACE "#pragma once\n" "#pragma once\n\n#ifndef TABULATE_HEADER_ONLY\n#  define TABULATE_HEADER_ONLY\n#endif\n" header "${header}")
+string(REPLACE "#pragma once\n" "" forward "${forward}")
+string(REPLACE "#include \"tabulate_fwd.h\"\n" "${forward}" header "${header}")
+string(REPLACE "#include \"tabulate.h\"\n" "" source "${source}")
+string(REPLACE "${include_source}" "${source}" header "${header}")
+
+file(WRITE "${OUTPUT}" "${header}")
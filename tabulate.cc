@@ -16,77 +16,73 @@
 
 #include <locale>
 #include <algorithm>
-#include <regex>
+#include <sstream>
+#include <iomanip>
+#include <ostream>
 #include <map>
 #include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <exception>
+#include <unordered_map>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <chrono>
+#include <limits>
+#include <cmath>
+#include <cctype>
+#include <cassert>
+#include <clocale>
+#include <wchar.h>
+#include <locale.h>
+#if defined(__unix__) || defined(__unix) || defined(__APPLE__)
+#  include <unistd.h>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/uio.h>
+#elif defined(_WIN32)
+#  include <io.h>
+#endif
+#if defined(__APPLE__)
+#  include <xlocale.h>
+#endif
+#if defined(TABULATE_HAS_ZLIB)
+#  include <zlib.h>
+#endif
+#if defined(TABULATE_HAS_ZSTD)
+#  include <zstd.h>
+#  include <zstd_errors.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#  include <emmintrin.h>
+#  define TABULATE_SSE2
+#endif
 #include "tabulate.h"
 
 namespace tabulate::symbols
 {
-// clang-format off
-static const std::map<std::string, std::vector<std::string>> graph_symbols = {
-  {
-    "braille_up", {
-      " ", "⢀", "⢠", "⢰", "⢸",
-      "⡀", "⣀", "⣠", "⣰", "⣸",
-      "⡄", "⣄", "⣤", "⣴", "⣼",
-      "⡆", "⣆", "⣦", "⣶", "⣾",
-      "⡇", "⣇", "⣧", "⣷", "⣿"
-    }
-  },
-  {
-    "braille_down", {
-      " ", "⠈", "⠘", "⠸", "⢸",
-      "⠁", "⠉", "⠙", "⠹", "⢹",
-      "⠃", "⠋", "⠛", "⠻", "⢻",
-      "⠇", "⠏", "⠟", "⠿", "⢿",
-      "⡇", "⡏", "⡟", "⡿", "⣿"
-    }
-  },
-  {
-    "block_up", {
-      " ", "▗", "▗", "▐", "▐",
-      "▖", "▄", "▄", "▟", "▟",
-      "▖", "▄", "▄", "▟", "▟",
-      "▌", "▙", "▙", "█", "█",
-      "▌", "▙", "▙", "█", "█"
-    }
-  },
-  {
-    "block_down", {
-      " ", "▝", "▝", "▐", "▐",
-      "▘", "▀", "▀", "▜", "▜",
-      "▘", "▀", "▀", "▜", "▜",
-      "▌", "▛", "▛", "█", "█",
-      "▌", "▛", "▛", "█", "█"
-    }
-  },
-  {
-    "tty_up", {
-      " ", "░", "░", "▒", "▒",
-      "░", "░", "▒", "▒", "█",
-      "░", "▒", "▒", "▒", "█",
-      "▒", "▒", "▒", "█", "█",
-      "▒", "█", "█", "█", "█"
-    }
-  },
-  {
-    "tty_down", {
-      " ", "░", "░", "▒", "▒",
-      "░", "░", "▒", "▒", "█",
-      "░", "▒", "▒", "▒", "█",
-      "▒", "▒", "▒", "█", "█",
-      "▒", "█", "█", "█", "█"
-    }
-  }
-};
-// clang-format on
-
-const std::vector<std::string> &get_graph_symbols(const std::string &name)
+TABULATE_INLINE const std::vector<std::string> &get_graph_symbols(const std::string &name)
 {
+  static constexpr std::array<std::string_view, 6> names = {"braille_up", "braille_down", "block_up", "block_down", "tty_up", "tty_down"};
+  static const std::vector<std::vector<std::string>> symbols = [] {
+    std::vector<std::vector<std::string>> symbols;
+    for (auto const &glyphs : graph_table) {
+      symbols.emplace_back(glyphs.begin(), glyphs.end());
+    }
+    return symbols;
+  }();
   static const std::vector<std::string> empty;
-  auto it = graph_symbols.find(name);
-  return it == graph_symbols.end() ? empty : it->second;
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (names[i] == name) {
+      return symbols[i];
+    }
+  }
+  return empty;
 }
 } // namespace tabulate::symbols
 
@@ -95,11 +91,11 @@ namespace tabulate
 #define BYTEn(v, n) (((v) >> ((n) * 8)) & 0xFF)
 
 // TrueColor implementation
-TrueColor::TrueColor() : hex(DEFAULT), color(Color::none) {}
+TABULATE_INLINE TrueColor::TrueColor() : hex(DEFAULT), color(Color::none) {}
 
-TrueColor::TrueColor(int hex) : hex(hex), color(Color::none) {}
+TABULATE_INLINE TrueColor::TrueColor(int hex) : hex(hex), color(Color::none) {}
 
-TrueColor::TrueColor(Color color) : color(color)
+TABULATE_INLINE TrueColor::TrueColor(Color color) : color(color)
 {
   switch (color) {
     case Color::black:
@@ -133,12 +129,12 @@ TrueColor::TrueColor(Color color) : color(color)
   }
 }
 
-std::tuple<unsigned char, unsigned char, unsigned char> TrueColor::RGB() const
+TABULATE_INLINE std::tuple<unsigned char, unsigned char, unsigned char> TrueColor::RGB() const
 {
   return std::make_tuple(BYTEn(hex, 2), BYTEn(hex, 1), BYTEn(hex, 0));
 }
 
-TrueColor TrueColor::merge(const TrueColor &a, const TrueColor &b)
+TABULATE_INLINE TrueColor TrueColor::merge(const TrueColor &a, const TrueColor &b)
 {
   int rr = (BYTEn(a.hex, 2) + BYTEn(b.hex, 2) + 1) / 2;
   int gg = (BYTEn(a.hex, 1) + BYTEn(b.hex, 1) + 1) / 2;
@@ -147,7 +143,18 @@ TrueColor TrueColor::merge(const TrueColor &a, const TrueColor &b)
   return TrueColor((rr << 16) | (gg << 8) | bb);
 }
 
-double TrueColor::similarity(const TrueColor &a, const TrueColor &b)
+TABULATE_INLINE TrueColor TrueColor::merge(const TrueColor &a, const TrueColor &b, double ratio)
+{
+  // 8-bit fixed point weight, merge(a, b, 0.5) equals merge(a, b)
+  int w = static_cast<int>(lround(std::min(std::max(ratio, 0.0), 1.0) * 256));
+  int rr = (BYTEn(a.hex, 2) * (256 - w) + BYTEn(b.hex, 2) * w + 128) >> 8;
+  int gg = (BYTEn(a.hex, 1) * (256 - w) + BYTEn(b.hex, 1) * w + 128) >> 8;
+  int bb = (BYTEn(a.hex, 0) * (256 - w) + BYTEn(b.hex, 0) * w + 128) >> 8;
+
+  return TrueColor((rr << 16) | (gg << 8) | bb);
+}
+
+TABULATE_INLINE double TrueColor::similarity(const TrueColor &a, const TrueColor &b)
 {
   // d = sqrt((r2-r1)^2 + (g2-g1)^2 + (b2-b1)^2)
   int dr = BYTEn(a.hex, 2) - BYTEn(b.hex, 2);
@@ -160,42 +167,291 @@ double TrueColor::similarity(const TrueColor &a, const TrueColor &b)
   return d / r;
 }
 
-Color TrueColor::most_similar(const TrueColor &a)
+TABULATE_INLINE Color TrueColor::most_similar(const TrueColor &a)
 {
-  struct color_distance {
+  if (a.none()) {
+    return Color::none;
+  }
+
+  // basic colors as constructed by TrueColor(Color), ties go to the first one
+  // clang-format off
+  static constexpr struct {
     Color color;
-    double distance;
+    int r, g, b;
+  } basics[] = {
+    {Color::black,   0x80, 0x80, 0x80},
+    {Color::red,     0xFF, 0x00, 0x00},
+    {Color::green,   0x00, 0x80, 0x00},
+    {Color::yellow,  0xFF, 0xFF, 0x00},
+    {Color::blue,    0x00, 0x00, 0xFF},
+    {Color::magenta, 0xFF, 0x00, 0xFF},
+    {Color::cyan,    0x00, 0xFF, 0xFF},
+    {Color::white,   0xFF, 0xFF, 0xFF},
+    {Color::none,    0x00, 0x00, 0x00},
+  };
+  // clang-format on
 
-    color_distance(const TrueColor &color, Color base) : color(base)
-    {
-      distance = similarity(color, base);
+  // squared euclidean distance orders colors the same as similarity() does
+  int rr = BYTEn(a.hex, 2), gg = BYTEn(a.hex, 1), bb = BYTEn(a.hex, 0);
+  Color nearest = Color::none;
+  int distance = 0x7FFFFFFF;
+  for (auto const &basic : basics) {
+    int dr = rr - basic.r, dg = gg - basic.g, db = bb - basic.b;
+    int d = dr * dr + dg * dg + db * db;
+    if (d < distance) {
+      distance = d;
+      nearest = basic.color;
     }
+  }
 
-    bool operator<(const color_distance &other) const
-    {
-      return (distance < other.distance);
-    }
-  };
+  return nearest;
+}
 
-  // clang-format off
-  std::vector<color_distance> distances = {
-    color_distance(a, Color::black),
-    color_distance(a, Color::red),
-    color_distance(a, Color::green),
-    color_distance(a, Color::yellow),
-    color_distance(a, Color::blue),
-    color_distance(a, Color::magenta),
-    color_distance(a, Color::cyan),
-    color_distance(a, Color::white),
-    color_distance(a, Color::none),
+TABULATE_INLINE int TrueColor::most_similar_256(const TrueColor &a)
+{
+  int rr = BYTEn(a.hex, 2), gg = BYTEn(a.hex, 1), bb = BYTEn(a.hex, 0);
+
+  // 6x6x6 cube, levels 0, 95, 135, 175, 215, 255
+  auto level = [](int v) -> int { return v < 48 ? 0 : v < 115 ? 1 : (v - 35) / 40; };
+  auto value = [](int l) -> int { return l == 0 ? 0 : 55 + l * 40; };
+  int rl = level(rr), gl = level(gg), bl = level(bb);
+  int cr = value(rl), cg = value(gl), cb = value(bl);
+
+  // grayscale ramp 232 - 255, levels 8, 18, ..., 238
+  int average = (rr + gg + bb) / 3;
+  int gray = average > 238 ? 23 : average < 8 ? 0 : (average - 3) / 10;
+  int gv = 8 + gray * 10;
+
+  auto distance = [&](int r, int g, int b) -> int {
+    return (rr - r) * (rr - r) + (gg - g) * (gg - g) + (bb - b) * (bb - b);
   };
-  // clang-format on
-  std::sort(distances.begin(), distances.end());
+  if (distance(gv, gv, gv) < distance(cr, cg, cb)) {
+    return 232 + gray;
+  }
+  return 16 + 36 * rl + 6 * gl + bl;
+}
+
+template <>
+TABULATE_INLINE std::string to_string<TrueColor>(const TrueColor &v)
+{
+  std::stringstream ss;
+  ss << "#" << std::setfill('0') << std::setw(6) << std::hex << v.hex;
+
+  return std::string(ss.str());
+}
+
+TABULATE_INLINE ColorMap::ColorMap(std::vector<TrueColor> stops, Scale scale) : stops(std::move(stops)), scale(scale), has_range(false), min(0), max(0) {}
+
+TABULATE_INLINE ColorMap &ColorMap::range(double min, double max)
+{
+  this->min = min;
+  this->max = max;
+  has_range = true;
+
+  return *this;
+}
+
+TABULATE_INLINE ColorMap ColorMap::fit(const double *values, size_t count) const
+{
+  if (has_range) {
+    return *this;
+  }
+
+  bool found = false;
+  double lo = 0, hi = 0;
+  for (size_t i = 0; i < count; i++) {
+    double value = values[i];
+    if (std::isnan(value) || (scale == Scale::log && value <= 0)) {
+      continue;
+    }
+    lo = found ? std::min(lo, value) : value;
+    hi = found ? std::max(hi, value) : value;
+    found = true;
+  }
+
+  ColorMap fitted(*this);
+  if (found) {
+    fitted.range(lo, hi);
+  }
+  return fitted;
+}
+
+namespace detail
+{
+// values are mapped in blocks of this many, with the scratch arrays on the stack
+constexpr size_t colormap_block = 256;
+
+// 8-bit fixed point offset along the segments of a gradient, from a position in [0, 1]
+TABULATE_INLINE int gradient_offset(double position, int segments)
+{
+  return static_cast<int>(position * segments * 256 + 0.5);
+}
+
+// interpolates between the two stops around an offset, as TrueColor::merge(a, b, ratio)
+TABULATE_INLINE TrueColor gradient_color(const std::vector<TrueColor> &stops, int segments, int offset)
+{
+  int k = std::min(offset >> 8, segments - 1);
+  int w = offset - (k << 8);
+  // a single stop is a gradient from the color to itself
+  int a = stops[std::min<size_t>(k, stops.size() - 1)].hex;
+  int b = stops[std::min<size_t>(k + 1, stops.size() - 1)].hex;
+  int rr = (BYTEn(a, 2) * (256 - w) + BYTEn(b, 2) * w + 128) >> 8;
+  int gg = (BYTEn(a, 1) * (256 - w) + BYTEn(b, 1) * w + 128) >> 8;
+  int bb = (BYTEn(a, 0) * (256 - w) + BYTEn(b, 0) * w + 128) >> 8;
+  return TrueColor((rr << 16) | (gg << 8) | bb);
+}
+} // namespace detail
+
+TABULATE_INLINE void ColorMap::map(const double *values, size_t count, TrueColor *colors) const
+{
+  if (stops.empty() || count == 0) {
+    std::fill(colors, colors + count, TrueColor());
+    return;
+  }
+  if (!has_range) {
+    ColorMap fitted = fit(values, count);
+    if (!fitted.has_range) {
+      std::fill(colors, colors + count, TrueColor());
+      return;
+    }
+    fitted.map(values, count, colors);
+    return;
+  }
+
+  double lo = min, hi = max;
+  const double tiny = std::numeric_limits<double>::min();
+  if (scale == Scale::log) {
+    lo = log(std::max(lo, tiny));
+    hi = log(std::max(hi, tiny));
+  }
+  const double scaler = hi > lo ? 1.0 / (hi - lo) : 0.0;
+  const int segments = static_cast<int>(std::max<size_t>(stops.size(), 2) - 1);
+
+  double logs[detail::colormap_block];
+  int offsets[detail::colormap_block];
+  for (size_t first = 0; first < count; first += detail::colormap_block) {
+    const size_t n = std::min(count - first, detail::colormap_block);
+    const double *in = values + first;
+    if (scale == Scale::log) {
+      for (size_t i = 0; i < n; i++) {
+        logs[i] = in[i] > tiny ? log(in[i]) : (in[i] == in[i] ? lo : in[i]);
+      }
+      in = logs;
+    }
+
+    // clamped offsets on the gradient, negative for NaN
+    size_t i = 0;
+#if defined(TABULATE_SSE2)
+    // max and min return NaN when it is the second operand, and NaN converts to INT_MIN
+    const __m128d zero = _mm_setzero_pd(), one = _mm_set1_pd(1.0), half = _mm_set1_pd(0.5);
+    const __m128d low = _mm_set1_pd(lo), factor = _mm_set1_pd(scaler), steps = _mm_set1_pd(segments * 256.0);
+    for (; i + 2 <= n; i += 2) {
+      __m128d t = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(in + i), low), factor);
+      t = _mm_min_pd(one, _mm_max_pd(zero, t));
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(offsets + i), _mm_cvttpd_epi32(_mm_add_pd(_mm_mul_pd(t, steps), half)));
+    }
+#endif
+    for (; i < n; i++) {
+      double t = (in[i] - lo) * scaler;
+      t = t < 0 ? 0 : (t > 1 ? 1 : t);
+      offsets[i] = t == t ? detail::gradient_offset(t, segments) : -1;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+      colors[first + i] = offsets[i] < 0 ? TrueColor() : detail::gradient_color(stops, segments, offsets[i]);
+    }
+  }
+}
+
+TABULATE_INLINE TrueColor ColorMap::operator()(double value) const
+{
+  // the single value path of map(), without blocks
+  if (stops.empty() || value != value) {
+    return TrueColor();
+  }
+  const int segments = static_cast<int>(std::max<size_t>(stops.size(), 2) - 1);
+  if (!has_range) {
+    // ranged to the value itself, which is the first stop if the scale takes it
+    return scale == Scale::log && value <= 0 ? TrueColor() : detail::gradient_color(stops, segments, 0);
+  }
+
+  double lo = min, hi = max;
+  const double tiny = std::numeric_limits<double>::min();
+  if (scale == Scale::log) {
+    lo = log(std::max(lo, tiny));
+    hi = log(std::max(hi, tiny));
+    value = value > tiny ? log(value) : lo;
+  }
+  const double scaler = hi > lo ? 1.0 / (hi - lo) : 0.0;
+  double t = (value - lo) * scaler;
+  t = t < 0 ? 0 : (t > 1 ? 1 : t);
+  return detail::gradient_color(stops, segments, detail::gradient_offset(t, segments));
+}
+
+TABULATE_INLINE Sparkline &Sparkline::range(double min, double max)
+{
+  this->min = min;
+  this->max = max;
+  has_range = true;
+  return *this;
+}
+
+TABULATE_INLINE std::string Sparkline::str() const
+{
+  if (count == 0) {
+    return "";
+  }
+
+  double lo = min, hi = max;
+  if (!has_range) {
+    bool found = false;
+    for (size_t i = 0; i < count; i++) {
+      if (!std::isnan(values[i])) {
+        lo = found ? std::min(lo, values[i]) : values[i];
+        hi = found ? std::max(hi, values[i]) : values[i];
+        found = true;
+      }
+    }
+  }
+
+  // bar height of every value, in levels of 1/4 line
+  size_t levels = 4 * height;
+  std::vector<size_t> bars(count + 1, 0);
+  for (size_t i = 0; i < count; i++) {
+    double value = values[i];
+    if (std::isnan(value)) {
+      continue;
+    }
+    double ratio = hi > lo ? (value - lo) / (hi - lo) : 0.5;
+    bars[i] = static_cast<size_t>(std::lround(std::min(std::max(ratio, 0.0), 1.0) * levels));
+  }
+
+  auto const &glyphs = symbols::graph_symbols(style);
+  bool down = style == symbols::GraphStyle::braille_down || style == symbols::GraphStyle::block_down || style == symbols::GraphStyle::tty_down;
+
+  std::string lines;
+  lines.reserve(height * (width() * 3 + NEWLINE.size()));
+  for (size_t line = 0; line < height; line++) {
+    // levels below the band of this line are drawn by the lines under it, or above it for the _down styles
+    size_t floor = 4 * (down ? line : height - 1 - line);
+    auto level = [&](size_t bar) -> size_t { return bar <= floor ? 0 : std::min<size_t>(bar - floor, 4); };
+    if (line != 0) {
+      lines += NEWLINE;
+    }
+    for (size_t i = 0; i < count; i += 2) {
+      lines += glyphs[5 * level(bars[i]) + level(bars[i + 1])];
+    }
+  }
+  return lines;
+}
 
-  return distances[0].color;
+template <>
+TABULATE_INLINE std::string to_string<Sparkline>(const Sparkline &v)
+{
+  return v.str();
 }
 
-Format::Format()
+TABULATE_INLINE Format::Format()
 {
   cell.width = 0;
   cell.height = 0;
@@ -317,7 +573,7 @@ Format::Format()
 }
 
 // Border methods
-Format &Format::border(const std::string &value)
+TABULATE_INLINE Format &Format::border(const std::string &value)
 {
   borders.left.content = value;
   borders.right.content = value;
@@ -326,7 +582,7 @@ Format &Format::border(const std::string &value)
   return *this;
 }
 
-Format &Format::border_padding(size_t value)
+TABULATE_INLINE Format &Format::border_padding(size_t value)
 {
   borders.left.padding = value;
   borders.right.padding = value;
@@ -335,7 +591,7 @@ Format &Format::border_padding(size_t value)
   return *this;
 }
 
-Format &Format::border_color(TrueColor value)
+TABULATE_INLINE Format &Format::border_color(TrueColor value)
 {
   borders.left.color = value;
   borders.right.color = value;
@@ -344,7 +600,7 @@ Format &Format::border_color(TrueColor value)
   return *this;
 }
 
-Format &Format::border_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::border_background_color(TrueColor value)
 {
   borders.left.background_color = value;
   borders.right.background_color = value;
@@ -353,97 +609,97 @@ Format &Format::border_background_color(TrueColor value)
   return *this;
 }
 
-Format &Format::border_left(const std::string &value)
+TABULATE_INLINE Format &Format::border_left(const std::string &value)
 {
   borders.left.content = value;
   return *this;
 }
 
-Format &Format::border_left_color(TrueColor value)
+TABULATE_INLINE Format &Format::border_left_color(TrueColor value)
 {
   borders.left.color = value;
   return *this;
 }
 
-Format &Format::border_left_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::border_left_background_color(TrueColor value)
 {
   borders.left.background_color = value;
   return *this;
 }
 
-Format &Format::border_left_padding(size_t value)
+TABULATE_INLINE Format &Format::border_left_padding(size_t value)
 {
   borders.left.padding = value;
   return *this;
 }
 
-Format &Format::border_right(const std::string &value)
+TABULATE_INLINE Format &Format::border_right(const std::string &value)
 {
   borders.right.content = value;
   return *this;
 }
 
-Format &Format::border_right_color(TrueColor value)
+TABULATE_INLINE Format &Format::border_right_color(TrueColor value)
 {
   borders.right.color = value;
   return *this;
 }
 
-Format &Format::border_right_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::border_right_background_color(TrueColor value)
 {
   borders.right.background_color = value;
   return *this;
 }
 
-Format &Format::border_right_padding(size_t value)
+TABULATE_INLINE Format &Format::border_right_padding(size_t value)
 {
   borders.right.padding = value;
   return *this;
 }
 
-Format &Format::border_top(const std::string &value)
+TABULATE_INLINE Format &Format::border_top(const std::string &value)
 {
   borders.top.content = value;
   return *this;
 }
 
-Format &Format::border_top_color(TrueColor value)
+TABULATE_INLINE Format &Format::border_top_color(TrueColor value)
 {
   borders.top.color = value;
   return *this;
 }
 
-Format &Format::border_top_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::border_top_background_color(TrueColor value)
 {
   borders.top.background_color = value;
   return *this;
 }
 
-Format &Format::border_top_padding(size_t value)
+TABULATE_INLINE Format &Format::border_top_padding(size_t value)
 {
   borders.top.padding = value;
   return *this;
 }
 
-Format &Format::border_bottom(const std::string &value)
+TABULATE_INLINE Format &Format::border_bottom(const std::string &value)
 {
   borders.bottom.content = value;
   return *this;
 }
 
-Format &Format::border_bottom_color(TrueColor value)
+TABULATE_INLINE Format &Format::border_bottom_color(TrueColor value)
 {
   borders.bottom.color = value;
   return *this;
 }
 
-Format &Format::border_bottom_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::border_bottom_background_color(TrueColor value)
 {
   borders.bottom.background_color = value;
   return *this;
 }
 
-Format &Format::show_border()
+TABULATE_INLINE Format &Format::show_border()
 {
   borders.left.visiable = true;
   borders.right.visiable = true;
@@ -452,7 +708,7 @@ Format &Format::show_border()
   return *this;
 }
 
-Format &Format::hide_border()
+TABULATE_INLINE Format &Format::hide_border()
 {
   borders.left.visiable = false;
   borders.right.visiable = false;
@@ -461,56 +717,56 @@ Format &Format::hide_border()
   return *this;
 }
 
-Format &Format::show_border_top()
+TABULATE_INLINE Format &Format::show_border_top()
 {
   borders.top.visiable = true;
   return *this;
 }
 
-Format &Format::hide_border_top()
+TABULATE_INLINE Format &Format::hide_border_top()
 {
   borders.top.visiable = false;
   return *this;
 }
 
-Format &Format::show_border_bottom()
+TABULATE_INLINE Format &Format::show_border_bottom()
 {
   borders.bottom.visiable = true;
   return *this;
 }
 
-Format &Format::hide_border_bottom()
+TABULATE_INLINE Format &Format::hide_border_bottom()
 {
   borders.bottom.visiable = false;
   return *this;
 }
 
-Format &Format::show_border_left()
+TABULATE_INLINE Format &Format::show_border_left()
 {
   borders.left.visiable = true;
   return *this;
 }
 
-Format &Format::hide_border_left()
+TABULATE_INLINE Format &Format::hide_border_left()
 {
   borders.left.visiable = false;
   return *this;
 }
 
-Format &Format::show_border_right()
+TABULATE_INLINE Format &Format::show_border_right()
 {
   borders.right.visiable = true;
   return *this;
 }
 
-Format &Format::hide_border_right()
+TABULATE_INLINE Format &Format::hide_border_right()
 {
   borders.right.visiable = false;
   return *this;
 }
 
 // Corner methods
-Format &Format::corner(const std::string &value)
+TABULATE_INLINE Format &Format::corner(const std::string &value)
 {
   corners.top_left.content = value;
   corners.top_right.content = value;
@@ -519,7 +775,7 @@ Format &Format::corner(const std::string &value)
   return *this;
 }
 
-Format &Format::corner_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_color(TrueColor value)
 {
   corners.top_left.color = value;
   corners.top_right.color = value;
@@ -528,7 +784,7 @@ Format &Format::corner_color(TrueColor value)
   return *this;
 }
 
-Format &Format::corner_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_background_color(TrueColor value)
 {
   corners.top_left.background_color = value;
   corners.top_right.background_color = value;
@@ -537,103 +793,103 @@ Format &Format::corner_background_color(TrueColor value)
   return *this;
 }
 
-Format &Format::corner_top_left(const std::string &value)
+TABULATE_INLINE Format &Format::corner_top_left(const std::string &value)
 {
   corners.top_left.content = value;
   return *this;
 }
 
-Format &Format::corner_top_left_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_top_left_color(TrueColor value)
 {
   corners.top_left.color = value;
   return *this;
 }
 
-Format &Format::corner_top_left_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_top_left_background_color(TrueColor value)
 {
   corners.top_left.background_color = value;
   return *this;
 }
 
-Format &Format::corner_top_right(const std::string &value)
+TABULATE_INLINE Format &Format::corner_top_right(const std::string &value)
 {
   corners.top_right.content = value;
   return *this;
 }
 
-Format &Format::corner_top_right_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_top_right_color(TrueColor value)
 {
   corners.top_right.color = value;
   return *this;
 }
 
-Format &Format::corner_top_right_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_top_right_background_color(TrueColor value)
 {
   corners.top_right.background_color = value;
   return *this;
 }
 
-Format &Format::corner_bottom_left(const std::string &value)
+TABULATE_INLINE Format &Format::corner_bottom_left(const std::string &value)
 {
   corners.bottom_left.content = value;
   return *this;
 }
 
-Format &Format::corner_bottom_left_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_bottom_left_color(TrueColor value)
 {
   corners.bottom_left.color = value;
   return *this;
 }
 
-Format &Format::corner_bottom_left_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_bottom_left_background_color(TrueColor value)
 {
   corners.bottom_left.background_color = value;
   return *this;
 }
 
-Format &Format::corner_bottom_right(const std::string &value)
+TABULATE_INLINE Format &Format::corner_bottom_right(const std::string &value)
 {
   corners.bottom_right.content = value;
   return *this;
 }
 
-Format &Format::corner_bottom_right_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_bottom_right_color(TrueColor value)
 {
   corners.bottom_right.color = value;
   return *this;
 }
 
-Format &Format::corner_bottom_right_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_bottom_right_background_color(TrueColor value)
 {
   corners.bottom_right.background_color = value;
   return *this;
 }
 
 // Internationalization methods
-const std::string &Format::locale() const
+TABULATE_INLINE const std::string &Format::locale() const
 {
   return internationlization.locale;
 }
 
-Format &Format::locale(const std::string &value)
+TABULATE_INLINE Format &Format::locale(const std::string &value)
 {
   internationlization.locale = value;
   return *this;
 }
 
-bool Format::multi_bytes_character() const
+TABULATE_INLINE bool Format::multi_bytes_character() const
 {
   return internationlization.multi_bytes_character;
 }
 
-Format &Format::multi_bytes_character(bool value)
+TABULATE_INLINE Format &Format::multi_bytes_character(bool value)
 {
   internationlization.multi_bytes_character = value;
   return *this;
 }
 
 // New border style methods
-Format &Format::border_style(Border::Style style)
+TABULATE_INLINE Format &Format::border_style(Border::Style style)
 {
   borders.left.style = style;
   borders.right.style = style;
@@ -642,32 +898,32 @@ Format &Format::border_style(Border::Style style)
   return *this;
 }
 
-Format &Format::border_left_style(Border::Style style)
+TABULATE_INLINE Format &Format::border_left_style(Border::Style style)
 {
   borders.left.style = style;
   return *this;
 }
 
-Format &Format::border_right_style(Border::Style style)
+TABULATE_INLINE Format &Format::border_right_style(Border::Style style)
 {
   borders.right.style = style;
   return *this;
 }
 
-Format &Format::border_top_style(Border::Style style)
+TABULATE_INLINE Format &Format::border_top_style(Border::Style style)
 {
   borders.top.style = style;
   return *this;
 }
 
-Format &Format::border_bottom_style(Border::Style style)
+TABULATE_INLINE Format &Format::border_bottom_style(Border::Style style)
 {
   borders.bottom.style = style;
   return *this;
 }
 
 // New border outer drawing methods
-Format &Format::draw_outer_border(bool value)
+TABULATE_INLINE Format &Format::draw_outer_border(bool value)
 {
   borders.left.draw_outer = value;
   borders.right.draw_outer = value;
@@ -676,32 +932,32 @@ Format &Format::draw_outer_border(bool value)
   return *this;
 }
 
-Format &Format::draw_outer_left_border(bool value)
+TABULATE_INLINE Format &Format::draw_outer_left_border(bool value)
 {
   borders.left.draw_outer = value;
   return *this;
 }
 
-Format &Format::draw_outer_right_border(bool value)
+TABULATE_INLINE Format &Format::draw_outer_right_border(bool value)
 {
   borders.right.draw_outer = value;
   return *this;
 }
 
-Format &Format::draw_outer_top_border(bool value)
+TABULATE_INLINE Format &Format::draw_outer_top_border(bool value)
 {
   borders.top.draw_outer = value;
   return *this;
 }
 
-Format &Format::draw_outer_bottom_border(bool value)
+TABULATE_INLINE Format &Format::draw_outer_bottom_border(bool value)
 {
   borders.bottom.draw_outer = value;
   return *this;
 }
 
 // New corner style methods
-Format &Format::corner_style(Corner::Style style)
+TABULATE_INLINE Format &Format::corner_style(Corner::Style style)
 {
   corners.top_left.style = style;
   corners.top_right.style = style;
@@ -710,32 +966,32 @@ Format &Format::corner_style(Corner::Style style)
   return *this;
 }
 
-Format &Format::corner_top_left_style(Corner::Style style)
+TABULATE_INLINE Format &Format::corner_top_left_style(Corner::Style style)
 {
   corners.top_left.style = style;
   return *this;
 }
 
-Format &Format::corner_top_right_style(Corner::Style style)
+TABULATE_INLINE Format &Format::corner_top_right_style(Corner::Style style)
 {
   corners.top_right.style = style;
   return *this;
 }
 
-Format &Format::corner_bottom_left_style(Corner::Style style)
+TABULATE_INLINE Format &Format::corner_bottom_left_style(Corner::Style style)
 {
   corners.bottom_left.style = style;
   return *this;
 }
 
-Format &Format::corner_bottom_right_style(Corner::Style style)
+TABULATE_INLINE Format &Format::corner_bottom_right_style(Corner::Style style)
 {
   corners.bottom_right.style = style;
   return *this;
 }
 
 // New corner outer drawing methods
-Format &Format::draw_outer_corner(bool value)
+TABULATE_INLINE Format &Format::draw_outer_corner(bool value)
 {
   corners.top_left.draw_outer = value;
   corners.top_right.draw_outer = value;
@@ -744,138 +1000,138 @@ Format &Format::draw_outer_corner(bool value)
   return *this;
 }
 
-Format &Format::draw_outer_top_left_corner(bool value)
+TABULATE_INLINE Format &Format::draw_outer_top_left_corner(bool value)
 {
   corners.top_left.draw_outer = value;
   return *this;
 }
 
-Format &Format::draw_outer_top_right_corner(bool value)
+TABULATE_INLINE Format &Format::draw_outer_top_right_corner(bool value)
 {
   corners.top_right.draw_outer = value;
   return *this;
 }
 
-Format &Format::draw_outer_bottom_left_corner(bool value)
+TABULATE_INLINE Format &Format::draw_outer_bottom_left_corner(bool value)
 {
   corners.bottom_left.draw_outer = value;
   return *this;
 }
 
-Format &Format::draw_outer_bottom_right_corner(bool value)
+TABULATE_INLINE Format &Format::draw_outer_bottom_right_corner(bool value)
 {
   corners.bottom_right.draw_outer = value;
   return *this;
 }
 
 // Format methods for setting corner cross junction properties
-Format &Format::corner_cross(const std::string &value)
+TABULATE_INLINE Format &Format::corner_cross(const std::string &value)
 {
   corners.cross.content = value;
   return *this;
 }
 
-Format &Format::corner_bottom_middle(const std::string &value)
+TABULATE_INLINE Format &Format::corner_bottom_middle(const std::string &value)
 {
   corners.bottom_middle.content = value;
   return *this;
 }
 
-Format &Format::corner_top_middle(const std::string &value)
+TABULATE_INLINE Format &Format::corner_top_middle(const std::string &value)
 {
   corners.top_middle.content = value;
   return *this;
 }
 
-Format &Format::corner_middle_right(const std::string &value)
+TABULATE_INLINE Format &Format::corner_middle_right(const std::string &value)
 {
   corners.middle_right.content = value;
   return *this;
 }
 
-Format &Format::corner_middle_left(const std::string &value)
+TABULATE_INLINE Format &Format::corner_middle_left(const std::string &value)
 {
   corners.middle_left.content = value;
   return *this;
 }
 
-Format &Format::corner_cross_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_cross_color(TrueColor value)
 {
   corners.cross.color = value;
   return *this;
 }
 
-Format &Format::corner_bottom_middle_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_bottom_middle_color(TrueColor value)
 {
   corners.bottom_middle.color = value;
   return *this;
 }
 
-Format &Format::corner_top_middle_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_top_middle_color(TrueColor value)
 {
   corners.top_middle.color = value;
   return *this;
 }
 
-Format &Format::corner_middle_right_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_middle_right_color(TrueColor value)
 {
   corners.middle_right.color = value;
   return *this;
 }
 
-Format &Format::corner_middle_left_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_middle_left_color(TrueColor value)
 {
   corners.middle_left.color = value;
   return *this;
 }
 
-Format &Format::corner_cross_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_cross_background_color(TrueColor value)
 {
   corners.cross.background_color = value;
   return *this;
 }
 
-Format &Format::corner_bottom_middle_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_bottom_middle_background_color(TrueColor value)
 {
   corners.bottom_middle.background_color = value;
   return *this;
 }
 
-Format &Format::corner_top_middle_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_top_middle_background_color(TrueColor value)
 {
   corners.top_middle.background_color = value;
   return *this;
 }
 
-Format &Format::corner_middle_right_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_middle_right_background_color(TrueColor value)
 {
   corners.middle_right.background_color = value;
   return *this;
 }
 
-Format &Format::corner_middle_left_background_color(TrueColor value)
+TABULATE_INLINE Format &Format::corner_middle_left_background_color(TrueColor value)
 {
   corners.middle_left.background_color = value;
   return *this;
 }
 
 // Method for setting bottom border padding
-Format &Format::border_bottom_padding(size_t value)
+TABULATE_INLINE Format &Format::border_bottom_padding(size_t value)
 {
   borders.bottom.padding = value;
   return *this;
 }
 
 // BatchFormat
-BatchFormat::BatchFormat(std::vector<std::shared_ptr<Cell>> cells) : cells(std::move(cells)) {}
+TABULATE_INLINE BatchFormat::BatchFormat(std::vector<std::shared_ptr<Cell>> cells) : cells(std::move(cells)) {}
 
 // Basic property methods
-size_t BatchFormat::size()
+TABULATE_INLINE size_t BatchFormat::size()
 {
   return cells.size();
 }
 
-BatchFormat &BatchFormat::width(size_t value)
+TABULATE_INLINE BatchFormat &BatchFormat::width(size_t value)
 {
   for (auto &cell : cells) {
     cell->format().width(value);
@@ -883,7 +1139,7 @@ BatchFormat &BatchFormat::width(size_t value)
   return *this;
 }
 
-BatchFormat &BatchFormat::align(Align value)
+TABULATE_INLINE BatchFormat &BatchFormat::align(Align value)
 {
   for (auto &cell : cells) {
     cell->format().align(value);
@@ -891,7 +1147,7 @@ BatchFormat &BatchFormat::align(Align value)
   return *this;
 }
 
-BatchFormat &BatchFormat::color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().color(value);
@@ -899,7 +1155,7 @@ BatchFormat &BatchFormat::color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::background_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::background_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().background_color(value);
@@ -907,7 +1163,7 @@ BatchFormat &BatchFormat::background_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::styles(Style value)
+TABULATE_INLINE BatchFormat &BatchFormat::styles(Style value)
 {
   for (auto &cell : cells) {
     cell->format().styles(value);
@@ -916,7 +1172,7 @@ BatchFormat &BatchFormat::styles(Style value)
 }
 
 // Border methods
-BatchFormat &BatchFormat::border_padding(size_t value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_padding(size_t value)
 {
   for (auto &cell : cells) {
     cell->format().border_padding(value);
@@ -924,7 +1180,7 @@ BatchFormat &BatchFormat::border_padding(size_t value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_left_padding(size_t value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_left_padding(size_t value)
 {
   for (auto &cell : cells) {
     cell->format().border_left_padding(value);
@@ -932,7 +1188,7 @@ BatchFormat &BatchFormat::border_left_padding(size_t value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_right_padding(size_t value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_right_padding(size_t value)
 {
   for (auto &cell : cells) {
     cell->format().border_right_padding(value);
@@ -940,7 +1196,7 @@ BatchFormat &BatchFormat::border_right_padding(size_t value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_top_padding(size_t value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_top_padding(size_t value)
 {
   for (auto &cell : cells) {
     cell->format().border_top_padding(value);
@@ -948,7 +1204,7 @@ BatchFormat &BatchFormat::border_top_padding(size_t value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_bottom_padding(size_t value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_bottom_padding(size_t value)
 {
   for (auto &cell : cells) {
     cell->format().border_bottom_padding(value);
@@ -956,7 +1212,7 @@ BatchFormat &BatchFormat::border_bottom_padding(size_t value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border(const std::string &value)
+TABULATE_INLINE BatchFormat &BatchFormat::border(const std::string &value)
 {
   for (auto &cell : cells) {
     cell->format().border(value);
@@ -964,7 +1220,7 @@ BatchFormat &BatchFormat::border(const std::string &value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().border_color(value);
@@ -972,7 +1228,7 @@ BatchFormat &BatchFormat::border_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_background_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_background_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().border_background_color(value);
@@ -980,7 +1236,7 @@ BatchFormat &BatchFormat::border_background_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_left(const std::string &value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_left(const std::string &value)
 {
   for (auto &cell : cells) {
     cell->format().border_left(value);
@@ -988,7 +1244,7 @@ BatchFormat &BatchFormat::border_left(const std::string &value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_left_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_left_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().border_left_color(value);
@@ -996,7 +1252,7 @@ BatchFormat &BatchFormat::border_left_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_left_background_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_left_background_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().border_left_background_color(value);
@@ -1004,7 +1260,7 @@ BatchFormat &BatchFormat::border_left_background_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_right(const std::string &value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_right(const std::string &value)
 {
   for (auto &cell : cells) {
     cell->format().border_right(value);
@@ -1012,7 +1268,7 @@ BatchFormat &BatchFormat::border_right(const std::string &value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_right_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_right_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().border_right_color(value);
@@ -1020,7 +1276,7 @@ BatchFormat &BatchFormat::border_right_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_right_background_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_right_background_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().border_right_background_color(value);
@@ -1028,7 +1284,7 @@ BatchFormat &BatchFormat::border_right_background_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_top(const std::string &value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_top(const std::string &value)
 {
   for (auto &cell : cells) {
     cell->format().border_top(value);
@@ -1036,7 +1292,7 @@ BatchFormat &BatchFormat::border_top(const std::string &value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_top_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_top_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().border_top_color(value);
@@ -1044,7 +1300,7 @@ BatchFormat &BatchFormat::border_top_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_top_background_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_top_background_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().border_top_background_color(value);
@@ -1052,7 +1308,7 @@ BatchFormat &BatchFormat::border_top_background_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_bottom(const std::string &value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_bottom(const std::string &value)
 {
   for (auto &cell : cells) {
     cell->format().border_bottom(value);
@@ -1060,7 +1316,7 @@ BatchFormat &BatchFormat::border_bottom(const std::string &value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_bottom_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_bottom_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().border_bottom_color(value);
@@ -1068,7 +1324,7 @@ BatchFormat &BatchFormat::border_bottom_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_bottom_background_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::border_bottom_background_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().border_bottom_background_color(value);
@@ -1077,7 +1333,7 @@ BatchFormat &BatchFormat::border_bottom_background_color(TrueColor value)
 }
 
 // Border visibility methods
-BatchFormat &BatchFormat::show_border()
+TABULATE_INLINE BatchFormat &BatchFormat::show_border()
 {
   for (auto &cell : cells) {
     cell->format().show_border();
@@ -1085,7 +1341,7 @@ BatchFormat &BatchFormat::show_border()
   return *this;
 }
 
-BatchFormat &BatchFormat::hide_border()
+TABULATE_INLINE BatchFormat &BatchFormat::hide_border()
 {
   for (auto &cell : cells) {
     cell->format().hide_border();
@@ -1093,7 +1349,7 @@ BatchFormat &BatchFormat::hide_border()
   return *this;
 }
 
-BatchFormat &BatchFormat::show_border_top()
+TABULATE_INLINE BatchFormat &BatchFormat::show_border_top()
 {
   for (auto &cell : cells) {
     cell->format().show_border_top();
@@ -1101,7 +1357,7 @@ BatchFormat &BatchFormat::show_border_top()
   return *this;
 }
 
-BatchFormat &BatchFormat::hide_border_top()
+TABULATE_INLINE BatchFormat &BatchFormat::hide_border_top()
 {
   for (auto &cell : cells) {
     cell->format().hide_border_top();
@@ -1109,7 +1365,7 @@ BatchFormat &BatchFormat::hide_border_top()
   return *this;
 }
 
-BatchFormat &BatchFormat::show_border_bottom()
+TABULATE_INLINE BatchFormat &BatchFormat::show_border_bottom()
 {
   for (auto &cell : cells) {
     cell->format().show_border_bottom();
@@ -1117,7 +1373,7 @@ BatchFormat &BatchFormat::show_border_bottom()
   return *this;
 }
 
-BatchFormat &BatchFormat::hide_border_bottom()
+TABULATE_INLINE BatchFormat &BatchFormat::hide_border_bottom()
 {
   for (auto &cell : cells) {
     cell->format().hide_border_bottom();
@@ -1125,7 +1381,7 @@ BatchFormat &BatchFormat::hide_border_bottom()
   return *this;
 }
 
-BatchFormat &BatchFormat::show_border_left()
+TABULATE_INLINE BatchFormat &BatchFormat::show_border_left()
 {
   for (auto &cell : cells) {
     cell->format().show_border_left();
@@ -1133,7 +1389,7 @@ BatchFormat &BatchFormat::show_border_left()
   return *this;
 }
 
-BatchFormat &BatchFormat::hide_border_left()
+TABULATE_INLINE BatchFormat &BatchFormat::hide_border_left()
 {
   for (auto &cell : cells) {
     cell->format().hide_border_left();
@@ -1141,7 +1397,7 @@ BatchFormat &BatchFormat::hide_border_left()
   return *this;
 }
 
-BatchFormat &BatchFormat::show_border_right()
+TABULATE_INLINE BatchFormat &BatchFormat::show_border_right()
 {
   for (auto &cell : cells) {
     cell->format().show_border_right();
@@ -1149,7 +1405,7 @@ BatchFormat &BatchFormat::show_border_right()
   return *this;
 }
 
-BatchFormat &BatchFormat::hide_border_right()
+TABULATE_INLINE BatchFormat &BatchFormat::hide_border_right()
 {
   for (auto &cell : cells) {
     cell->format().hide_border_right();
@@ -1158,7 +1414,7 @@ BatchFormat &BatchFormat::hide_border_right()
 }
 
 // Corner methods
-BatchFormat &BatchFormat::corner(const std::string &value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner(const std::string &value)
 {
   for (auto &cell : cells) {
     cell->format().corner(value);
@@ -1166,7 +1422,7 @@ BatchFormat &BatchFormat::corner(const std::string &value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().corner_color(value);
@@ -1174,7 +1430,7 @@ BatchFormat &BatchFormat::corner_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_background_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_background_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().corner_background_color(value);
@@ -1182,7 +1438,7 @@ BatchFormat &BatchFormat::corner_background_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_top_left(const std::string &value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_top_left(const std::string &value)
 {
   for (auto &cell : cells) {
     cell->format().corner_top_left(value);
@@ -1190,7 +1446,7 @@ BatchFormat &BatchFormat::corner_top_left(const std::string &value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_top_left_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_top_left_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().corner_top_left_color(value);
@@ -1198,7 +1454,7 @@ BatchFormat &BatchFormat::corner_top_left_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_top_left_background_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_top_left_background_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().corner_top_left_background_color(value);
@@ -1206,7 +1462,7 @@ BatchFormat &BatchFormat::corner_top_left_background_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_top_right(const std::string &value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_top_right(const std::string &value)
 {
   for (auto &cell : cells) {
     cell->format().corner_top_right(value);
@@ -1214,7 +1470,7 @@ BatchFormat &BatchFormat::corner_top_right(const std::string &value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_top_right_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_top_right_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().corner_top_right_color(value);
@@ -1222,7 +1478,7 @@ BatchFormat &BatchFormat::corner_top_right_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_top_right_background_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_top_right_background_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().corner_top_right_background_color(value);
@@ -1230,7 +1486,7 @@ BatchFormat &BatchFormat::corner_top_right_background_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_bottom_left(const std::string &value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_bottom_left(const std::string &value)
 {
   for (auto &cell : cells) {
     cell->format().corner_bottom_left(value);
@@ -1238,7 +1494,7 @@ BatchFormat &BatchFormat::corner_bottom_left(const std::string &value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_bottom_left_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_bottom_left_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().corner_bottom_left_color(value);
@@ -1246,7 +1502,7 @@ BatchFormat &BatchFormat::corner_bottom_left_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_bottom_left_background_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_bottom_left_background_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().corner_bottom_left_background_color(value);
@@ -1254,7 +1510,7 @@ BatchFormat &BatchFormat::corner_bottom_left_background_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_bottom_right(const std::string &value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_bottom_right(const std::string &value)
 {
   for (auto &cell : cells) {
     cell->format().corner_bottom_right(value);
@@ -1262,7 +1518,7 @@ BatchFormat &BatchFormat::corner_bottom_right(const std::string &value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_bottom_right_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_bottom_right_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().corner_bottom_right_color(value);
@@ -1270,7 +1526,7 @@ BatchFormat &BatchFormat::corner_bottom_right_color(TrueColor value)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_bottom_right_background_color(TrueColor value)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_bottom_right_background_color(TrueColor value)
 {
   for (auto &cell : cells) {
     cell->format().corner_bottom_right_background_color(value);
@@ -1279,7 +1535,7 @@ BatchFormat &BatchFormat::corner_bottom_right_background_color(TrueColor value)
 }
 
 // Internationalization methods
-BatchFormat &BatchFormat::locale(const std::string &value)
+TABULATE_INLINE BatchFormat &BatchFormat::locale(const std::string &value)
 {
   for (auto &cell : cells) {
     cell->format().locale(value);
@@ -1287,7 +1543,7 @@ BatchFormat &BatchFormat::locale(const std::string &value)
   return *this;
 }
 
-BatchFormat &BatchFormat::multi_bytes_character(bool value)
+TABULATE_INLINE BatchFormat &BatchFormat::multi_bytes_character(bool value)
 {
   for (auto &cell : cells) {
     cell->format().multi_bytes_character(value);
@@ -1296,7 +1552,7 @@ BatchFormat &BatchFormat::multi_bytes_character(bool value)
 }
 
 // New border style methods for BatchFormat
-BatchFormat &BatchFormat::border_style(Border::Style style)
+TABULATE_INLINE BatchFormat &BatchFormat::border_style(Border::Style style)
 {
   for (auto &cell : cells) {
     cell->format().border_style(style);
@@ -1304,7 +1560,7 @@ BatchFormat &BatchFormat::border_style(Border::Style style)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_left_style(Border::Style style)
+TABULATE_INLINE BatchFormat &BatchFormat::border_left_style(Border::Style style)
 {
   for (auto &cell : cells) {
     cell->format().border_left_style(style);
@@ -1312,7 +1568,7 @@ BatchFormat &BatchFormat::border_left_style(Border::Style style)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_right_style(Border::Style style)
+TABULATE_INLINE BatchFormat &BatchFormat::border_right_style(Border::Style style)
 {
   for (auto &cell : cells) {
     cell->format().border_right_style(style);
@@ -1320,7 +1576,7 @@ BatchFormat &BatchFormat::border_right_style(Border::Style style)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_top_style(Border::Style style)
+TABULATE_INLINE BatchFormat &BatchFormat::border_top_style(Border::Style style)
 {
   for (auto &cell : cells) {
     cell->format().border_top_style(style);
@@ -1328,7 +1584,7 @@ BatchFormat &BatchFormat::border_top_style(Border::Style style)
   return *this;
 }
 
-BatchFormat &BatchFormat::border_bottom_style(Border::Style style)
+TABULATE_INLINE BatchFormat &BatchFormat::border_bottom_style(Border::Style style)
 {
   for (auto &cell : cells) {
     cell->format().border_bottom_style(style);
@@ -1337,7 +1593,7 @@ BatchFormat &BatchFormat::border_bottom_style(Border::Style style)
 }
 
 // New border outer drawing methods for BatchFormat
-BatchFormat &BatchFormat::draw_outer_border(bool value)
+TABULATE_INLINE BatchFormat &BatchFormat::draw_outer_border(bool value)
 {
   for (auto &cell : cells) {
     cell->format().draw_outer_border(value);
@@ -1345,7 +1601,7 @@ BatchFormat &BatchFormat::draw_outer_border(bool value)
   return *this;
 }
 
-BatchFormat &BatchFormat::draw_outer_left_border(bool value)
+TABULATE_INLINE BatchFormat &BatchFormat::draw_outer_left_border(bool value)
 {
   for (auto &cell : cells) {
     cell->format().draw_outer_left_border(value);
@@ -1353,7 +1609,7 @@ BatchFormat &BatchFormat::draw_outer_left_border(bool value)
   return *this;
 }
 
-BatchFormat &BatchFormat::draw_outer_right_border(bool value)
+TABULATE_INLINE BatchFormat &BatchFormat::draw_outer_right_border(bool value)
 {
   for (auto &cell : cells) {
     cell->format().draw_outer_right_border(value);
@@ -1361,7 +1617,7 @@ BatchFormat &BatchFormat::draw_outer_right_border(bool value)
   return *this;
 }
 
-BatchFormat &BatchFormat::draw_outer_top_border(bool value)
+TABULATE_INLINE BatchFormat &BatchFormat::draw_outer_top_border(bool value)
 {
   for (auto &cell : cells) {
     cell->format().draw_outer_top_border(value);
@@ -1369,7 +1625,7 @@ BatchFormat &BatchFormat::draw_outer_top_border(bool value)
   return *this;
 }
 
-BatchFormat &BatchFormat::draw_outer_bottom_border(bool value)
+TABULATE_INLINE BatchFormat &BatchFormat::draw_outer_bottom_border(bool value)
 {
   for (auto &cell : cells) {
     cell->format().draw_outer_bottom_border(value);
@@ -1378,7 +1634,7 @@ BatchFormat &BatchFormat::draw_outer_bottom_border(bool value)
 }
 
 // New corner style methods for BatchFormat
-BatchFormat &BatchFormat::corner_style(Corner::Style style)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_style(Corner::Style style)
 {
   for (auto &cell : cells) {
     cell->format().corner_style(style);
@@ -1386,7 +1642,7 @@ BatchFormat &BatchFormat::corner_style(Corner::Style style)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_top_left_style(Corner::Style style)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_top_left_style(Corner::Style style)
 {
   for (auto &cell : cells) {
     cell->format().corner_top_left_style(style);
@@ -1394,7 +1650,7 @@ BatchFormat &BatchFormat::corner_top_left_style(Corner::Style style)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_top_right_style(Corner::Style style)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_top_right_style(Corner::Style style)
 {
   for (auto &cell : cells) {
     cell->format().corner_top_right_style(style);
@@ -1402,7 +1658,7 @@ BatchFormat &BatchFormat::corner_top_right_style(Corner::Style style)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_bottom_left_style(Corner::Style style)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_bottom_left_style(Corner::Style style)
 {
   for (auto &cell : cells) {
     cell->format().corner_bottom_left_style(style);
@@ -1410,7 +1666,7 @@ BatchFormat &BatchFormat::corner_bottom_left_style(Corner::Style style)
   return *this;
 }
 
-BatchFormat &BatchFormat::corner_bottom_right_style(Corner::Style style)
+TABULATE_INLINE BatchFormat &BatchFormat::corner_bottom_right_style(Corner::Style style)
 {
   for (auto &cell : cells) {
     cell->format().corner_bottom_right_style(style);
@@ -1419,7 +1675,7 @@ BatchFormat &BatchFormat::corner_bottom_right_style(Corner::Style style)
 }
 
 // New corner outer drawing methods for BatchFormat
-BatchFormat &BatchFormat::draw_outer_corner(bool value)
+TABULATE_INLINE BatchFormat &BatchFormat::draw_outer_corner(bool value)
 {
   for (auto &cell : cells) {
     cell->format().draw_outer_corner(value);
@@ -1427,7 +1683,7 @@ BatchFormat &BatchFormat::draw_outer_corner(bool value)
   return *this;
 }
 
-BatchFormat &BatchFormat::draw_outer_top_left_corner(bool value)
+TABULATE_INLINE BatchFormat &BatchFormat::draw_outer_top_left_corner(bool value)
 {
   for (auto &cell : cells) {
     cell->format().draw_outer_top_left_corner(value);
@@ -1435,7 +1691,7 @@ BatchFormat &BatchFormat::draw_outer_top_left_corner(bool value)
   return *this;
 }
 
-BatchFormat &BatchFormat::draw_outer_top_right_corner(bool value)
+TABULATE_INLINE BatchFormat &BatchFormat::draw_outer_top_right_corner(bool value)
 {
   for (auto &cell : cells) {
     cell->format().draw_outer_top_right_corner(value);
@@ -1443,7 +1699,7 @@ BatchFormat &BatchFormat::draw_outer_top_right_corner(bool value)
   return *this;
 }
 
-BatchFormat &BatchFormat::draw_outer_bottom_left_corner(bool value)
+TABULATE_INLINE BatchFormat &BatchFormat::draw_outer_bottom_left_corner(bool value)
 {
   for (auto &cell : cells) {
     cell->format().draw_outer_bottom_left_corner(value);
@@ -1451,7 +1707,7 @@ BatchFormat &BatchFormat::draw_outer_bottom_left_corner(bool value)
   return *this;
 }
 
-BatchFormat &BatchFormat::draw_outer_bottom_right_corner(bool value)
+TABULATE_INLINE BatchFormat &BatchFormat::draw_outer_bottom_right_corner(bool value)
 {
   for (auto &cell : cells) {
     cell->format().draw_outer_bottom_right_corner(value);
@@ -1463,34 +1719,34 @@ BatchFormat &BatchFormat::draw_outer_bottom_right_corner(bool value)
 namespace tabulate
 {
 // Cell class methods implementation
-Cell::Cell(const std::string &content) : content_(content) {}
+TABULATE_INLINE Cell::Cell(const std::string &content) : content_(content) {}
 
-const std::string &Cell::get() const
+TABULATE_INLINE const std::string &Cell::get() const
 {
   return content_;
 }
 
-void Cell::set(const std::string &content)
+TABULATE_INLINE void Cell::set(const std::string &content)
 {
   content_ = content;
 }
 
-size_t Cell::size()
+TABULATE_INLINE size_t Cell::size()
 {
   return display_width_of(content_, m_format.locale(), m_format.multi_bytes_character());
 }
 
-Format &Cell::format()
+TABULATE_INLINE Format &Cell::format()
 {
   return m_format;
 }
 
-const Format &Cell::format() const
+TABULATE_INLINE const Format &Cell::format() const
 {
   return m_format;
 }
 
-size_t Cell::width() const
+TABULATE_INLINE size_t Cell::width() const
 {
   if (m_format.width() != 0) {
     return m_format.width();
@@ -1511,22 +1767,22 @@ size_t Cell::width() const
   }
 }
 
-Align Cell::align() const
+TABULATE_INLINE Align Cell::align() const
 {
   return m_format.align();
 }
 
-TrueColor Cell::color() const
+TABULATE_INLINE TrueColor Cell::color() const
 {
   return m_format.color();
 }
 
-TrueColor Cell::background_color() const
+TABULATE_INLINE TrueColor Cell::background_color() const
 {
   return m_format.background_color();
 }
 
-Styles Cell::styles() const
+TABULATE_INLINE Styles Cell::styles() const
 {
   return m_format.styles();
 }
@@ -1534,554 +1790,668 @@ Styles Cell::styles() const
 
 namespace tabulate
 {
-size_t display_width_of(const std::string &text, const std::string &locale, bool wchar_enabled)
+namespace detail
 {
-  // delete ansi escape sequences
-  std::regex e("\x1b(?:[@-Z\\-_]|\\[[0-?]*[ -/]*[@-~])");
-  std::string str = std::regex_replace(text, e, "");
-
-  if (!wchar_enabled) {
-    return str.length();
-  }
+#if defined(TABULATE_RENDER_STATS)
+// statistics attached to the renders of this thread by RenderStatsScope
+TABULATE_INLINE thread_local RenderStats *active_stats = nullptr;
 
-  if (str.size() == 0) {
-    return 0;
+// adds the time until the end of the scope to a phase of the attached statistics
+class PhaseTimer {
+ public:
+  explicit PhaseTimer(uint64_t RenderStats::*phase) : stats(active_stats), phase(phase)
+  {
+    if (stats != nullptr) {
+      start = std::chrono::steady_clock::now();
+    }
   }
 
-  // XXX: Markus Kuhn's open-source wcswidth.c
-#if defined(__unix__) || defined(__unix) || defined(__APPLE__)
+  ~PhaseTimer()
   {
-    // The behavior of wcswidth() depends on the LC_CTYPE category of the current locale.
-    // Set the current locale based on cell properties before computing width
-    auto old_locale = std::locale::global(std::locale(locale));
-
-    // Convert from narrow std::string to wide string
-    wchar_t stackbuff[128], *wstr = stackbuff;
-    if (str.size() > 128) {
-      wstr = new wchar_t[str.size()];
+    if (stats != nullptr) {
+      stats->*phase += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
     }
+  }
 
-    std::mbstowcs(wstr, str.c_str(), str.size());
+ private:
+  RenderStats *stats;
+  uint64_t RenderStats::*phase;
+  std::chrono::steady_clock::time_point start;
+};
 
-    // Compute display width of wide string
-    int len = wcswidth(wstr, str.size());
+TABULATE_INLINE RenderStats *attached_stats()
+{
+  return active_stats;
+}
 
-    if (wstr != stackbuff) {
-      delete[] wstr;
-    }
+#  define TABULATE_STATS_ADD(counter, n)                       \
+    do {                                                       \
+      if (::tabulate::detail::active_stats != nullptr) {       \
+        ::tabulate::detail::active_stats->counter += (n);      \
+      }                                                        \
+    } while (0)
+#  define TABULATE_STATS_PHASE(phase) ::tabulate::detail::PhaseTimer XCONCAT(phase_timer_, __LINE__)(&RenderStats::phase)
+#else
+TABULATE_INLINE RenderStats *attached_stats()
+{
+  return nullptr;
+}
 
-    // Restore old locale
-    std::locale::global(old_locale);
+#  define TABULATE_STATS_ADD(counter, n) ((void)0)
+#  define TABULATE_STATS_PHASE(phase)    ((void)0)
+#endif
+} // namespace detail
 
-    if (len >= 0) {
-      return len;
-    }
-  }
+TABULATE_INLINE bool RenderStats::enabled()
+{
+#if defined(TABULATE_RENDER_STATS)
+  return true;
+#else
+  return false;
 #endif
+}
 
-  {
-    return (str.length() - std::count_if(str.begin(), str.end(), [](char c) -> bool { return (c & 0xC0) == 0x80; }));
-  }
+TABULATE_INLINE void RenderStats::count_allocation(size_t bytes)
+{
+  TABULATE_STATS_ADD(allocations, 1);
+  TABULATE_STATS_ADD(allocated_bytes, bytes);
+  (void)bytes;
 }
 
-std::string lstrip(const std::string &s)
+TABULATE_INLINE RenderStats &RenderStats::operator+=(const RenderStats &other)
 {
-  std::string trimed = s;
-  trimed.erase(trimed.begin(), std::find_if(trimed.begin(), trimed.end(), [](int ch) { return !std::isspace(ch); }));
-  return trimed;
+  rows += other.rows;
+  cells += other.cells;
+  width_calls += other.width_calls;
+  width_bytes += other.width_bytes;
+  wraps += other.wraps;
+  sgrs += other.sgrs;
+  output_bytes += other.output_bytes;
+  allocations += other.allocations;
+  allocated_bytes += other.allocated_bytes;
+  layout_ns += other.layout_ns;
+  dump_ns += other.dump_ns;
+  join_ns += other.join_ns;
+
+  return *this;
 }
 
-std::string replace_all(std::string str, const std::string &from, const std::string &to)
+TABULATE_INLINE RenderStatsScope::RenderStatsScope(RenderStats &stats) : previous(detail::attached_stats())
 {
-  size_t curr = 0;
-  while ((curr = str.find(from, curr)) != std::string::npos) {
-    str.replace(curr, from.length(), to);
-    curr += to.length(); // Handles case where 'to' is a substring of 'from'
-  }
-  return str;
+#if defined(TABULATE_RENDER_STATS)
+  detail::active_stats = &stats;
+#else
+  (void)stats;
+#endif
 }
 
-std::vector<std::string> explode_string(const std::string &input, const std::vector<std::string> &separators)
+TABULATE_INLINE RenderStatsScope::~RenderStatsScope()
 {
-  auto first_of = [](const std::string &input, size_t start, const std::vector<std::string> &separators) -> size_t {
-    std::vector<size_t> indices;
-    for (auto &c : separators) {
-      auto index = input.find(c, start);
-      if (index != std::string::npos) {
-        indices.push_back(index);
-      }
-    }
-    if (indices.size() > 0) {
-      return *std::min_element(indices.begin(), indices.end());
-    } else {
-      return std::string::npos;
-    }
-  };
+#if defined(TABULATE_RENDER_STATS)
+  detail::active_stats = previous;
+#endif
+}
 
-  std::vector<std::string> segments;
+namespace detail
+{
+#if defined(TABULATE_TRACE)
+struct TraceEvent {
+  const char *name;
+  const char *arg; // name of the argument, nullptr for none
+  long long value;
+  uint64_t begin, duration; // nanoseconds since start()
+  unsigned int tid;
+};
 
-  size_t start = 0;
-  while (true) {
-    auto index = first_of(input, start, separators);
+// events of one thread, written out in chunks so a long trace does not accumulate in memory
+struct TraceBuffer {
+  std::mutex mutex;
+  unsigned int session = 0; // session the events belong to
+  std::chrono::steady_clock::time_point origin;
+  std::vector<TraceEvent> events;
+};
 
-    if (index == std::string::npos) {
-      segments.push_back(input.substr(start));
-      return segments;
-    }
+constexpr size_t trace_chunk = 1024;
 
-    std::string word = input.substr(start, index - start);
-    char next_character = input.substr(index, 1)[0];
-    // Unlike whitespace, dashes and the like should stick to the word occurring before it.
-    if (isspace(next_character)) {
-      segments.push_back(word);
-      segments.push_back(std::string(1, next_character));
-    } else {
-      segments.push_back(word + next_character);
-    }
-    start = index + 1;
-  }
+struct TraceLog {
+  std::mutex mutex; // taken after the mutex of a buffer, never before
+  std::atomic<bool> recording{false};
+  std::atomic<unsigned int> session{0}; // odd while recording
+  FILE *file = nullptr;
+  size_t written = 0;
+  std::chrono::steady_clock::time_point origin;
+  std::vector<std::shared_ptr<TraceBuffer>> buffers; // threads that recorded in this session
+};
 
-  return segments;
+TABULATE_INLINE TraceLog &trace_log()
+{
+  static TraceLog log;
+  return log;
 }
 
-std::vector<std::string> wrap_lines(const std::string &str, size_t width, const std::string &locale, bool multi_bytes_character)
+TABULATE_INLINE unsigned int trace_tid()
 {
-  std::vector<std::string> lines;
-  {
-    std::string line;
-    std::stringstream ss(str);
-    while (std::getline(ss, line, '\n')) {
-      if (display_width_of(line, locale, multi_bytes_character) <= width) {
-        lines.push_back(line);
-        continue;
-      }
-      std::string wrapped;
-      auto words = explode_string(line, {" ", "-", "\t"});
-      for (auto &word : words) {
-        if (display_width_of(wrapped, locale, multi_bytes_character) + display_width_of(word, locale, multi_bytes_character) > width) {
-          if (display_width_of(wrapped, locale, multi_bytes_character) > 0) {
-            lines.push_back(wrapped);
-            wrapped = "";
-          }
+  static std::atomic<unsigned int> next{1};
+  static thread_local unsigned int tid = next++;
+  return tid;
+}
 
-          while (display_width_of(word, locale, multi_bytes_character) > width) {
-            wrapped = word.substr(0, width - 1) + "-";
-            lines.push_back(wrapped);
-            wrapped = "";
-            word = word.substr(width - 1);
-          }
+// the buffer outlives its thread until stop() has written it
+TABULATE_INLINE const std::shared_ptr<TraceBuffer> &trace_buffer()
+{
+  static thread_local std::shared_ptr<TraceBuffer> buffer = std::make_shared<TraceBuffer>();
+  return buffer;
+}
 
-          word = lstrip(word);
-        }
+// timestamps are in microseconds, log.mutex held
+TABULATE_INLINE void write_trace_events(TraceLog &log, const std::vector<TraceEvent> &events)
+{
+  for (auto const &event : events) {
+    fprintf(log.file, "%s\n{\"name\":\"%s\",\"cat\":\"tabulate\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f", log.written == 0 ? "" : ",",
+            event.name, event.tid, event.begin / 1000.0, event.duration / 1000.0);
+    if (event.arg != nullptr) {
+      fprintf(log.file, ",\"args\":{\"%s\":%lld}", event.arg, event.value);
+    }
+    fprintf(log.file, "}");
+    log.written++;
+  }
+}
 
-        wrapped += word;
+// records a complete event from construction to the end of the scope
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char *name, const char *arg = nullptr, long long value = 0)
+      : recording(trace_log().recording.load(std::memory_order_relaxed)), name(name), arg(arg), value(value)
+  {
+    if (recording) {
+      start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~TraceSpan()
+  {
+    if (!recording) {
+      return;
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto &log = trace_log();
+    auto &buffer = trace_buffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    if (buffer->session != log.session.load()) {
+      // first span of the thread in this session
+      std::lock_guard<std::mutex> registering(log.mutex);
+      if (!log.recording) {
+        return;
       }
-      lines.push_back(wrapped);
+      buffer->events.clear();
+      buffer->session = log.session;
+      buffer->origin = log.origin;
+      log.buffers.push_back(buffer);
+    }
+
+    uint64_t begin = std::chrono::duration_cast<std::chrono::nanoseconds>(start - buffer->origin).count();
+    uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    buffer->events.push_back({name, arg, value, begin, duration, trace_tid()});
+    if (buffer->events.size() >= trace_chunk) {
+      std::lock_guard<std::mutex> writing(log.mutex);
+      if (log.session == buffer->session) {
+        write_trace_events(log, buffer->events);
+      }
+      buffer->events.clear();
     }
   }
 
-  return lines;
-}
+ private:
+  bool recording;
+  const char *name;
+  const char *arg;
+  long long value;
+  std::chrono::steady_clock::time_point start;
+};
+
+#  define TABULATE_TRACE_SPAN(...) ::tabulate::detail::TraceSpan XCONCAT(trace_span_, __LINE__)(__VA_ARGS__)
+#else
+#  define TABULATE_TRACE_SPAN(...) ((void)0)
+#endif
+} // namespace detail
 
-std::string expand_to_size(const std::string &s, size_t len, bool multi_bytes_character)
+namespace trace
 {
-  std::string r;
-  if (s == "") {
-    return std::string(' ', len);
-  }
-  if (len == 0) {
-    return s;
+TABULATE_INLINE bool start(const std::string &path)
+{
+#if defined(TABULATE_TRACE)
+  auto &log = detail::trace_log();
+  std::lock_guard<std::mutex> lock(log.mutex);
+  if (log.file != nullptr) {
+    return false;
   }
-  size_t swidth = display_width_of(s, "", multi_bytes_character);
-  for (size_t i = 0; i < len;) {
-    if (swidth > len - i) {
-      r += s.substr(0, len - i);
-    } else {
-      r += s;
-    }
-    i += swidth;
+  log.file = fopen(path.c_str(), "w");
+  if (log.file == nullptr) {
+    return false;
   }
-  return r;
+  fprintf(log.file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  log.written = 0;
+  log.origin = std::chrono::steady_clock::now();
+  log.session++;
+  log.recording = true;
+  return true;
+#else
+  (void)path;
+  return false;
+#endif
 }
-} // namespace tabulate
 
-namespace tabulate
-{
-// Row implementation
-// Basic access methods
-Cell &Row::operator[](size_t index)
+TABULATE_INLINE void stop()
 {
-  if (index >= cells.size()) {
-    size_t size = index - cells.size() + 1;
-    for (size_t i = 0; i < size; i++) {
-      add("");
+#if defined(TABULATE_TRACE)
+  auto &log = detail::trace_log();
+  std::vector<std::shared_ptr<detail::TraceBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock(log.mutex);
+    if (log.file == nullptr || !log.recording) {
+      return;
     }
+    log.recording = false;
+    log.session++;
+    buffers.swap(log.buffers);
   }
-  return *cells[index];
-}
 
-const Cell &Row::operator[](size_t index) const
-{
-  return *cells[index];
-}
+  // spans ending from now on see the new session and are dropped
+  for (auto const &buffer : buffers) {
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    std::lock_guard<std::mutex> writing(log.mutex);
+    detail::write_trace_events(log, buffer->events);
+    std::vector<detail::TraceEvent>().swap(buffer->events);
+  }
 
-std::shared_ptr<Cell> &Row::cell(size_t index)
-{
-  return cells[index];
+  std::lock_guard<std::mutex> lock(log.mutex);
+  fprintf(log.file, "\n]}\n");
+  fclose(log.file);
+  log.file = nullptr;
+#endif
 }
+} // namespace trace
 
-size_t Row::size() const
+namespace detail
 {
-  return cells.size();
-}
+/**
+ * Per-thread memo tables used while rendering. Every table a thread renders
+ * shares them, so a worker of render_batch() pays for each distinct width,
+ * border glyph run and SGR sequence only once.
+ */
+struct RenderCache {
+  static constexpr size_t MAX_ENTRIES = 4096;
 
-// Format methods
-BatchFormat Row::format()
-{
-  return BatchFormat(cells);
-}
+  std::string width_locale;
+  std::unordered_map<std::string, size_t> widths;
+  std::unordered_map<std::string, std::string> glyphs;
+  std::unordered_map<std::string, std::string> sgrs;
+#if defined(__unix__) || defined(__unix) || defined(__APPLE__)
+  std::map<std::string, locale_t> locales;
+  std::wstring wbuffer;
 
-BatchFormat Row::format(size_t from, size_t to)
-{
-  std::vector<std::shared_ptr<Cell>> selected_cells;
-  for (size_t i = std::min(from, to); i <= std::max(from, to); i++) {
-    selected_cells.push_back(cells[i]);
+  ~RenderCache()
+  {
+    for (auto &it : locales) {
+      if (it.second != (locale_t)0) {
+        freelocale(it.second);
+      }
+    }
   }
-  return BatchFormat(selected_cells);
-}
+#endif
 
-BatchFormat Row::format(std::initializer_list<std::tuple<size_t, size_t>> ranges)
-{
-  std::vector<std::shared_ptr<Cell>> selected_cells;
-  for (auto range : ranges) {
-    for (size_t i = std::min(std::get<0>(range), std::get<1>(range)); i < std::max(std::get<0>(range), std::get<1>(range)); i++) {
-      selected_cells.push_back(cells[i]);
+  template <typename Map>
+  static void bound(Map &map)
+  {
+    if (map.size() >= MAX_ENTRIES) {
+      map.clear();
     }
   }
-  return BatchFormat(selected_cells);
-}
+};
 
-// Iterator methods
-Row::iterator Row::begin()
+TABULATE_INLINE RenderCache &render_cache()
 {
-  return iterator(cells.begin());
+  static thread_local RenderCache cache;
+  return cache;
 }
 
-Row::iterator Row::end()
+// size of the ansi escape sequence at offset i, 0 for none: \x1b(?:[@-Z\-_]|\[[0-?]*[ -/]*[@-~])
+TABULATE_INLINE size_t escape_size(const std::string &text, size_t i)
 {
-  return iterator(cells.end());
+  size_t n = text.size();
+  if (text[i] != '\x1b' || i + 1 >= n) {
+    return 0;
+  }
+  char c = text[i + 1];
+  if ((c >= '@' && c <= 'Z') || c == '-' || c == '_') {
+    return 2;
+  }
+  if (c == '[') {
+    size_t j = i + 2;
+    while (j < n && text[j] >= '0' && text[j] <= '?') {
+      j++;
+    }
+    while (j < n && text[j] >= ' ' && text[j] <= '/') {
+      j++;
+    }
+    if (j < n && text[j] >= '@' && text[j] <= '~') {
+      return j + 1 - i;
+    }
+  }
+  return 0;
 }
 
-Row::const_iterator Row::begin() const
+// strip ansi escape sequences
+TABULATE_INLINE std::string strip_escapes(const std::string &text)
 {
-  return const_iterator(cells.cbegin());
+  std::string str;
+  str.reserve(text.size());
+  for (size_t i = 0, n = text.size(); i < n;) {
+    size_t size = escape_size(text, i);
+    if (size > 0) {
+      i += size;
+    } else {
+      str += text[i++];
+    }
+  }
+  return str;
 }
 
-Row::const_iterator Row::end() const
+TABULATE_INLINE size_t count_code_points(const std::string &str)
 {
-  return const_iterator(cells.cend());
+  return str.length() - std::count_if(str.begin(), str.end(), [](char c) -> bool { return (c & 0xC0) == 0x80; });
 }
+} // namespace detail
 
-// Display methods
-std::vector<std::string> Row::dump(StringFormatter stringformatter, BorderFormatter borderformatter, CornerFormatter cornerformatter, size_t row_index,
-                                   size_t header_count, size_t total_rows) const
+TABULATE_INLINE size_t display_width_of(const std::string &text, const std::string &locale, bool wchar_enabled)
 {
-  size_t max_height = 0;
-  std::vector<std::vector<std::string>> dumplines;
+  TABULATE_STATS_ADD(width_calls, 1);
+  TABULATE_STATS_ADD(width_bytes, text.size());
 
-  // Determine format directly based on row_index and total_rows
-  bool showtop = true;
-  bool showbottom = (row_index == total_rows - 1);
-  bool is_middle_row = (row_index > 0 && row_index < total_rows - 1);
+  // plain ascii: every byte is one column
+  if (std::all_of(text.begin(), text.end(), [](char c) { return c != '\x1b' && (c & 0x80) == 0; })) {
+    return text.size();
+  }
 
-  // Special case for single row in to_string<Row> context
-  if (total_rows <= 1) {
-    showbottom = true;
-    is_middle_row = false;
+  std::string str = detail::strip_escapes(text);
+
+  if (!wchar_enabled) {
+    return str.length();
   }
 
-  for (auto const &cell : cells) {
-    // #ifdef __DEBUG__
-    //       std::cout << "cell: " << cell->get() << std::endl;
-    //       std::cout << "\tcolor: " << to_string(cell->color()) << std::endl;
-    //       std::cout << "\tbackground_color: " << to_string(cell->background_color()) << std::endl;
-    //       if (!cell->styles().empty()) {
-    //         std::cout << "\tstyles: ";
-    //         for (auto &style : cell->styles()) {
-    //           std::cout << to_string(style);
-    //           if (&style != &cell->styles().back()) {
-    //             std::cout << " ";
-    //           }
-    //         }
-    //         std::cout << std::endl;
-    //       }
-    // #endif
-    std::vector<std::string> wrapped;
-    if (cell->width() == 0) {
-      wrapped.push_back(cell->get());
-    } else {
-      wrapped = wrap_lines(cell->get(), cell->width(), cell->format().locale(), cell->format().multi_bytes_character());
-      // #ifdef __DEBUG__
-      //         std::cout << "wrap to " << wrapped.size() << " lines" << std::endl;
-      // #endif
-    }
-    max_height = std::max(wrapped.size(), max_height);
-    dumplines.push_back(wrapped);
+  if (str.size() == 0) {
+    return 0;
   }
 
-  std::vector<std::string> lines;
-  if (showtop && cells.size() > 0 && cells[0]->format().borders.top.visiable) {
-    std::string line;
+  auto &cache = detail::render_cache();
+  if (cache.width_locale != locale) {
+    cache.widths.clear();
+    cache.width_locale = locale;
+  }
+  auto cached = cache.widths.find(str);
+  if (cached != cache.widths.end()) {
+    return cached->second;
+  }
 
-    // Start with appropriate left corner type based on row position
-    Which left_corner_type;
-    if (is_middle_row) {
-      // For middle rows, use middle_left (├) at the left edge
-      left_corner_type = Which::middle_left;
-    } else if (row_index == total_rows - 1) {
-      // For the last row, use bottom_left if it's also the first row, otherwise use middle_left
-      left_corner_type = (row_index == 0) ? Which::top_left : Which::middle_left;
-    } else {
-      // For the first row, use top_left
-      left_corner_type = Which::top_left;
-    }
+  size_t width = detail::count_code_points(str);
 
-    line += cornerformatter(left_corner_type, cells[0].get(), nullptr, nullptr, nullptr, nullptr, stringformatter);
+  // XXX: Markus Kuhn's open-source wcswidth.c
+#if defined(__unix__) || defined(__unix) || defined(__APPLE__)
+  {
+    // The behavior of wcswidth() depends on the LC_CTYPE category of the current locale.
+    // Switch the calling thread (only) to the cell locale before computing width
+    auto it = cache.locales.find(locale);
+    if (it == cache.locales.end()) {
+      it = cache.locales.emplace(locale, newlocale(LC_CTYPE_MASK, locale.c_str(), (locale_t)0)).first;
+    }
 
-    for (size_t i = 0; i < cells.size(); i++) {
-      auto cell = cells[i].get();
-      auto left = i > 0 ? cells[i - 1].get() : nullptr;
-      auto right = (i + 1 < cells.size()) ? cells[i + 1].get() : nullptr;
+    if (it->second != (locale_t)0) {
+      locale_t old_locale = uselocale(it->second);
 
-      auto &borders = cell->format().borders;
-      size_t size = borders.left.padding + cell->width() + borders.right.padding;
+      // Convert from narrow std::string to wide string
+      cache.wbuffer.resize(str.size() + 1);
+      size_t count = std::mbstowcs(&cache.wbuffer[0], str.c_str(), str.size() + 1);
 
-      // Use border formatter with the appropriate border type
-      line += borderformatter(Which::top, cell, left, right, nullptr, nullptr, size, stringformatter);
-
-      // Select appropriate corner type for the junction to the right of the current cell
-      Which corner_type;
-      if (i < cells.size() - 1) {
-        // For internal junctions
-        if (is_middle_row) {
-          // Middle rows use cross (┼) for internal junctions
-          corner_type = Which::cross;
-        } else if (row_index == total_rows - 1) {
-          // Last row uses bottom_middle (┴) for internal junctions if not the first row
-          corner_type = (row_index == 0) ? Which::top_middle : Which::cross;
-        } else {
-          // First row uses top_middle (┬) for internal junctions
-          corner_type = Which::top_middle;
-        }
-      } else {
-        // For the right edge
-        if (is_middle_row) {
-          // Middle rows use middle_right (┤) at the right edge
-          corner_type = Which::middle_right;
-        } else if (row_index == total_rows - 1) {
-          // Last row uses bottom_right if it's also the first row, otherwise use middle_right
-          corner_type = (row_index == 0) ? Which::top_right : Which::middle_right;
-        } else {
-          // First row uses top_right at the right edge
-          corner_type = Which::top_right;
+      // Compute display width of wide string, invalid multibyte sequences keep the fallback
+      if (count != static_cast<size_t>(-1)) {
+        int len = wcswidth(cache.wbuffer.c_str(), count);
+        if (len >= 0) {
+          width = len;
         }
       }
 
-      line += cornerformatter(corner_type, cell, nullptr, nullptr, nullptr, nullptr, stringformatter);
+      // Restore old locale
+      uselocale(old_locale);
     }
-    lines.push_back(line);
   }
+#endif
 
-  // padding lines on top
-  if (cells[0]->format().borders.top.padding > 0) {
-    std::string padline;
-    for (size_t i = 0; i < cells.size(); i++) {
-      auto cell = cells[i].get();
-      auto &borders = cell->format().borders;
-      auto left = i > 0 ? cells[i - 1].get() : nullptr;
-      auto right = (i + 1 < cells.size()) ? cells[i + 1].get() : nullptr;
-      size_t size = borders.left.padding + cell->width() + borders.right.padding;
+  detail::RenderCache::bound(cache.widths);
+  cache.widths.emplace(str, width);
 
-      padline += borderformatter(Which::left, cell, left, right, nullptr, nullptr, 1, stringformatter);
-      padline += stringformatter(std::string(size, ' '), Color::none, cell->background_color(), {});
-    }
-    padline += borderformatter(Which::right, cells.back().get(), nullptr, nullptr, nullptr, nullptr, 1, stringformatter);
+  return width;
+}
 
-    for (size_t i = 0; i < cells[0]->format().borders.top.padding; i++) {
-      lines.push_back(padline);
-    }
+TABULATE_INLINE std::string lstrip(const std::string &s)
+{
+  std::string trimed = s;
+  trimed.erase(trimed.begin(), std::find_if(trimed.begin(), trimed.end(), [](int ch) { return !std::isspace(ch); }));
+  return trimed;
+}
+
+TABULATE_INLINE std::string replace_all(std::string str, const std::string &from, const std::string &to)
+{
+  size_t curr = 0;
+  while ((curr = str.find(from, curr)) != std::string::npos) {
+    str.replace(curr, from.length(), to);
+    curr += to.length(); // Handles case where 'to' is a substring of 'from'
   }
+  return str;
+}
 
-  // border padding words padding sepeartor padding words padding sepeartor border
-  for (size_t i = 0; i < max_height; i++) {
-    std::string line;
-    line += borderformatter(Which::left, cells[0].get(), nullptr, cells.size() >= 2 ? cells[1].get() : nullptr, nullptr, nullptr, 1, stringformatter);
-    for (size_t j = 0; j < cells.size(); j++) {
-      auto cell = cells[j].get();
-      auto left = j > 0 ? cells[j - 1].get() : nullptr;
-      auto right = (j + 1 < cells.size()) ? cells[j + 1].get() : nullptr;
-      auto foreground_color = cell->color();
-      auto background_color = cell->background_color();
-      size_t cell_offset = 0, empty_lines = max_height - dumplines[j].size();
-      auto alignment = cell->format().align();
-      if (alignment & Align::bottom) {
-        cell_offset = empty_lines;
-      } else if (alignment & Align::top) {
-        cell_offset = 0;
-      } else { // DEFAULT: align center in vertical
-        cell_offset = empty_lines / 2;
+TABULATE_INLINE std::vector<std::string> explode_string(const std::string &input, const std::vector<std::string> &separators)
+{
+  // next occurrence of every separator, searched again only once passed, so the input is scanned once per separator
+  std::vector<size_t> found(separators.size(), 0);
+  std::vector<bool> searched(separators.size(), false);
+  auto first_of = [&](size_t start) -> size_t {
+    size_t first = std::string::npos;
+    for (size_t k = 0; k < separators.size(); k++) {
+      if (!searched[k] || (found[k] != std::string::npos && found[k] < start)) {
+        found[k] = input.find(separators[k], start);
+        searched[k] = true;
       }
-      line += stringformatter(std::string(cell->format().borders.left.padding, ' '), Color::none, background_color, {});
-      if (i < cell_offset || i >= dumplines[j].size() + cell_offset) {
-        line += stringformatter(std::string(cell->width(), ' '), Color::none, background_color, cell->styles());
-      } else {
-        auto align_line_by = [&](const std::string &str, size_t width, Align align, const std::string &locale, bool multi_bytes_character) -> std::string {
-          size_t linesize = display_width_of(str, locale, multi_bytes_character);
-          if (linesize >= width) {
-            return stringformatter(str, foreground_color, background_color, cell->styles());
-          }
-          if (align & Align::hcenter) {
-            size_t remains = width - linesize;
-            return stringformatter(std::string(remains / 2, ' '), Color::none, background_color, {})
-                   + stringformatter(str, foreground_color, background_color, cell->styles())
-                   + stringformatter(std::string((remains + 1) / 2, ' '), Color::none, background_color, {});
-          } else if (align & Align::right) {
-            return stringformatter(std::string(width - linesize, ' '), Color::none, background_color, {})
-                   + stringformatter(str, foreground_color, background_color, cell->styles());
-          } else { // DEFAULT: align left in horizontal
-            return stringformatter(str, foreground_color, background_color, cell->styles())
-                   + stringformatter(std::string(width - linesize, ' '), Color::none, background_color, {});
-          }
-        };
+      first = std::min(first, found[k]);
+    }
+    return first;
+  };
 
-        line += align_line_by(dumplines[j][i - cell_offset], cell->width(), alignment, cell->format().locale(), cell->format().multi_bytes_character());
-      }
+  std::vector<std::string> segments;
 
-      line += stringformatter(std::string(cell->format().borders.right.padding, ' '), Color::none, background_color, {});
+  size_t start = 0;
+  while (true) {
+    auto index = first_of(start);
 
-      // Use appropriate border type for cell separators or right border
-      Which border_type = Which::right;
-      line += borderformatter(border_type, cell, left, right, nullptr, nullptr, 1, stringformatter);
+    if (index == std::string::npos) {
+      segments.push_back(input.substr(start));
+      return segments;
     }
 
-    lines.push_back(line);
+    std::string word = input.substr(start, index - start);
+    char next_character = input[index];
+    // Unlike whitespace, dashes and the like should stick to the word occurring before it.
+    if (isspace(next_character)) {
+      segments.push_back(word);
+      segments.push_back(std::string(1, next_character));
+    } else {
+      segments.push_back(word + next_character);
+    }
+    start = index + 1;
   }
 
-  // padding lines on bottom
-  if (cells.back()->format().borders.bottom.padding > 0) {
-    std::string padline;
-    for (size_t i = 0; i < cells.size(); i++) {
-      auto cell = cells[i].get();
-      auto &borders = cell->format().borders;
-      auto left = i > 0 ? cells[i - 1].get() : nullptr;
-      auto right = (i + 1 < cells.size()) ? cells[i + 1].get() : nullptr;
-      size_t size = borders.left.padding + cell->width() + borders.right.padding;
-
-      padline += borderformatter(Which::left, cell, left, right, nullptr, nullptr, 1, stringformatter);
-      padline += stringformatter(std::string(size, ' '), Color::none, cell->background_color(), {});
-    }
-    padline += borderformatter(Which::right, cells.back().get(), nullptr, nullptr, nullptr, nullptr, 1, stringformatter);
+  return segments;
+}
 
-    for (size_t i = 0; i < cells.back()->format().borders.bottom.padding; i++) {
-      lines.push_back(padline);
-    }
+namespace detail
+{
+// size in bytes of the glyph at offset i: a whole escape sequence, a UTF-8 sequence or a byte
+TABULATE_INLINE size_t glyph_size(const std::string &str, size_t i, bool multi_bytes_character)
+{
+  size_t size = escape_size(str, i);
+  if (size > 0) {
+    return size;
+  }
+  unsigned char c = str[i];
+  if (!multi_bytes_character || c < 0xC0) {
+    return 1;
   }
+  size = c >= 0xF0 ? 4 : (c >= 0xE0 ? 3 : 2);
+  return std::min(size, str.size() - i);
+}
+} // namespace detail
+
+TABULATE_INLINE std::vector<std::string> wrap_lines(const std::string &str, size_t width, const std::string &locale, bool multi_bytes_character)
+{
+  TABULATE_STATS_ADD(wraps, 1);
 
-  if (showbottom && cells.size() > 0 && cells.back()->format().borders.bottom.visiable) {
+  std::vector<std::string> lines;
+  {
     std::string line;
+    std::stringstream ss(str);
+    while (std::getline(ss, line, '\n')) {
+      if (display_width_of(line, locale, multi_bytes_character) <= width) {
+        lines.push_back(line);
+        continue;
+      }
+      std::string wrapped;
+      size_t wrapped_width = 0;
+      auto words = explode_string(line, {" ", "-", "\t"});
+      for (auto &word : words) {
+        size_t word_width = display_width_of(word, locale, multi_bytes_character);
+        if (wrapped_width + word_width > width) {
+          if (wrapped_width > 0) {
+            lines.push_back(wrapped);
+            wrapped = "";
+            wrapped_width = 0;
+          }
 
-    // Start with appropriate left corner type based on row position
-    Which left_corner_type;
-    if (is_middle_row) {
-      // For middle rows, use middle_left (├) at the left edge
-      left_corner_type = Which::middle_left;
-    } else if (row_index == total_rows - 1) {
-      // For the last row, use bottom_left at the left edge
-      left_corner_type = Which::bottom_left;
-    } else {
-      // For the first row (if showing bottom border), use middle_left
-      left_corner_type = Which::middle_left;
+          // break words longer than a line glyph by glyph in one pass, leaving room for the hyphen
+          if (word_width > width) {
+            size_t room = width > 1 ? width - 1 : 1;
+            size_t offset = 0;
+            while (word_width > width && offset < word.size()) {
+              std::string chunk;
+              size_t chunk_width = 0;
+              while (offset < word.size()) {
+                size_t size = detail::glyph_size(word, offset, multi_bytes_character);
+                std::string glyph = word.substr(offset, size);
+                size_t glyph_width = display_width_of(glyph, locale, multi_bytes_character);
+                if (chunk_width > 0 && chunk_width + glyph_width > room) {
+                  break;
+                }
+                chunk += glyph;
+                chunk_width += glyph_width;
+                offset += size;
+              }
+              // a glyph as wide as the line leaves no room for the hyphen
+              lines.push_back(width > 1 && chunk_width < width ? chunk + "-" : chunk);
+              word_width -= std::min(word_width, chunk_width);
+            }
+            word = word.substr(offset);
+          }
+
+          word = lstrip(word);
+          word_width = display_width_of(word, locale, multi_bytes_character);
+        }
+
+        wrapped += word;
+        wrapped_width += word_width;
+      }
+      lines.push_back(wrapped);
     }
+  }
 
-    line += cornerformatter(left_corner_type, cells[0].get(), nullptr, nullptr, nullptr, nullptr, stringformatter);
+  return lines;
+}
 
-    for (size_t i = 0; i < cells.size(); i++) {
-      auto cell = cells[i].get();
-      auto left = i > 0 ? cells[i - 1].get() : nullptr;
-      auto right = (i + 1 < cells.size()) ? cells[i + 1].get() : nullptr;
+TABULATE_INLINE std::string expand_to_size(const std::string &s, size_t len, bool multi_bytes_character)
+{
+  std::string r;
+  if (s == "") {
+    return std::string(len, ' ');
+  }
+  if (len == 0) {
+    return s;
+  }
 
-      auto &borders = cell->format().borders;
-      size_t size = borders.left.padding + cell->width() + borders.right.padding;
+  auto &cache = detail::render_cache();
+  std::string key = s;
+  key.append(reinterpret_cast<const char *>(&len), sizeof(len));
+  key += multi_bytes_character ? '\1' : '\0';
+  auto cached = cache.glyphs.find(key);
+  if (cached != cache.glyphs.end()) {
+    return cached->second;
+  }
 
-      // Use border formatter with the appropriate border type
-      line += borderformatter(Which::bottom, cell, left, right, nullptr, nullptr, size, stringformatter);
-
-      // Select appropriate corner type for the junction to the right of the current cell
-      Which corner_type;
-      if (i < cells.size() - 1) {
-        // For internal junctions
-        if (is_middle_row) {
-          // Middle rows use cross (┼) for internal junctions
-          corner_type = Which::cross;
-        } else if (row_index == total_rows - 1) {
-          // Last row uses bottom_middle (┴) for internal junctions
-          corner_type = Which::bottom_middle;
-        } else {
-          // First or other non-last rows use cross for internal junctions if showing bottom
-          corner_type = Which::cross;
-        }
-      } else {
-        // For the right edge
-        if (is_middle_row) {
-          // Middle rows use middle_right (┤) at the right edge
-          corner_type = Which::middle_right;
-        } else if (row_index == total_rows - 1) {
-          // Last row uses bottom_right at the right edge
-          corner_type = Which::bottom_right;
-        } else {
-          // First or other non-last rows use middle_right at the right edge if showing bottom
-          corner_type = Which::middle_right;
-        }
-      }
+  // nothing visible to repeat
+  size_t swidth = display_width_of(s, "", multi_bytes_character);
+  if (swidth == 0) {
+    return s;
+  }
 
-      // Ensure proper junction characters are used
-      line += cornerformatter(corner_type, cell, nullptr, nullptr, nullptr, nullptr, stringformatter);
+  for (size_t i = 0; i < len;) {
+    if (swidth > len - i) {
+      r += s.substr(0, len - i);
+    } else {
+      r += s;
     }
-    lines.push_back(line);
+    i += swidth;
   }
 
-  return lines;
+  detail::RenderCache::bound(cache.glyphs);
+  cache.glyphs.emplace(std::move(key), r);
+
+  return r;
 }
+} // namespace tabulate
 
-// Column implementation
+namespace tabulate
+{
+// Row implementation
 // Basic access methods
-void Column::add(std::shared_ptr<Cell> cell)
+TABULATE_INLINE Cell &Row::operator[](size_t index)
 {
-  cells.push_back(cell);
+  if (index >= cells.size()) {
+    size_t size = index - cells.size() + 1;
+    for (size_t i = 0; i < size; i++) {
+      add("");
+    }
+  }
+  return *cells[index];
 }
 
-BatchFormat Column::format()
+TABULATE_INLINE const Cell &Row::operator[](size_t index) const
 {
-  return BatchFormat(cells);
+  return *cells[index];
 }
 
-size_t Column::size()
+TABULATE_INLINE std::shared_ptr<Cell> &Row::cell(size_t index)
 {
-  return cells.size();
+  return cells[index];
 }
 
-Cell &Column::operator[](size_t index)
+TABULATE_INLINE size_t Row::size() const
 {
-  return *cells[index];
+  return cells.size();
 }
 
-const Cell &Column::operator[](size_t index) const
+// Format methods
+TABULATE_INLINE BatchFormat Row::format()
 {
-  return *cells[index];
+  return BatchFormat(cells);
 }
 
-// Format methods
-BatchFormat Column::format(size_t from, size_t to)
+TABULATE_INLINE BatchFormat Row::format(size_t from, size_t to)
 {
   std::vector<std::shared_ptr<Cell>> selected_cells;
   for (size_t i = std::min(from, to); i <= std::max(from, to); i++) {
@@ -2090,7 +2460,7 @@ BatchFormat Column::format(size_t from, size_t to)
   return BatchFormat(selected_cells);
 }
 
-BatchFormat Column::format(std::initializer_list<std::tuple<size_t, size_t>> ranges)
+TABULATE_INLINE BatchFormat Row::format(std::initializer_list<std::tuple<size_t, size_t>> ranges)
 {
   std::vector<std::shared_ptr<Cell>> selected_cells;
   for (auto range : ranges) {
@@ -2102,659 +2472,2870 @@ BatchFormat Column::format(std::initializer_list<std::tuple<size_t, size_t>> ran
 }
 
 // Iterator methods
-Column::iterator Column::begin()
+TABULATE_INLINE Row::iterator Row::begin()
 {
   return iterator(cells.begin());
 }
 
-Column::iterator Column::end()
+TABULATE_INLINE Row::iterator Row::end()
 {
   return iterator(cells.end());
 }
 
-Column::const_iterator Column::begin() const
+TABULATE_INLINE Row::const_iterator Row::begin() const
 {
   return const_iterator(cells.cbegin());
 }
 
-Column::const_iterator Column::end() const
+TABULATE_INLINE Row::const_iterator Row::end() const
 {
   return const_iterator(cells.cend());
 }
-} // namespace tabulate
 
-namespace tabulate::xterm
+// Display methods
+namespace detail
 {
-bool has_truecolor()
+// corner of a border line of Row::dump(), at edge 0 (left), 1 to count - 1 (between cells) or count (right)
+TABULATE_INLINE Which corner_of(bool top, size_t edge, size_t count, bool is_middle_row, bool is_last_row, bool is_first_row)
 {
-  const char *term = getenv("TERM");
-  if (term == NULL) {
-    term = "";
+  // the line above a row joins the row before it, the line below only closes the last row
+  bool inner = top ? is_middle_row || (is_last_row && !is_first_row) : is_middle_row || !is_last_row;
+  if (edge == 0) {
+    return inner ? Which::middle_left : top ? Which::top_left : Which::bottom_left;
+  } else if (edge < count) {
+    return inner ? Which::cross : top ? Which::top_middle : Which::bottom_middle;
+  }
+  return inner ? Which::middle_right : top ? Which::top_right : Which::bottom_right;
+}
+} // namespace detail
+
+namespace detail
+{
+// output of Row::__layout() that builds the lines of Row::dump()
+class LineBuilder {
+ public:
+  explicit LineBuilder(const StringFormatter &stringformatter) : stringformatter(stringformatter) {}
+
+  void glyphs(std::string &&formatted)
+  {
+    line += formatted;
+  }
+
+  void text(const std::string &text, TrueColor foreground, TrueColor background, const Styles &styles)
+  {
+    line += stringformatter(text, foreground, background, styles);
+  }
+
+  void spaces(size_t count, TrueColor background, const Styles &styles)
+  {
+    line += stringformatter(std::string(count, ' '), Color::none, background, styles);
+  }
+
+  void begin_cell(size_t) {}
+
+  void end_line()
+  {
+    lines.push_back(std::move(line));
+    line.clear();
+  }
+
+  std::vector<std::string> lines;
+
+ private:
+  const StringFormatter &stringformatter;
+  std::string line;
+};
+
+// output of Row::__layout() that only counts the bytes and lines of Row::dump(), formatters
+// wrap their text, so the size of a formatted empty string is the overhead of any text
+class SizeCounter {
+ public:
+  explicit SizeCounter(const StringFormatter &stringformatter) : stringformatter(stringformatter) {}
+
+  void glyphs(std::string &&formatted)
+  {
+    size += formatted.size();
+  }
+
+  void text(const std::string &text, TrueColor foreground, TrueColor background, const Styles &styles)
+  {
+    size += stringformatter("", foreground, background, styles).size() + text.size();
+  }
+
+  void spaces(size_t count, TrueColor background, const Styles &styles)
+  {
+    size += stringformatter("", Color::none, background, styles).size() + count;
+  }
+
+  void begin_cell(size_t) {}
+
+  void end_line()
+  {
+    lines++;
+  }
+
+  size_t size = 0;
+  size_t lines = 0;
+
+ private:
+  const StringFormatter &stringformatter;
+};
+
+// output of Row::__layout() that records where every cell is drawn, in lines of the row and
+// columns of the screen, for ProgressUpdater. The formatters must not add escape sequences
+class PositionRecorder {
+ public:
+  struct Place {
+    size_t first = std::numeric_limits<size_t>::max(), last = 0; // lines of the cell, padding lines included
+    size_t column = 0;                                           // where its left padding starts
+    size_t text_line = std::numeric_limits<size_t>::max();       // line of its first text
+  };
+
+  explicit PositionRecorder(const Row &row) : places(row.size()), row(row) {}
+
+  void glyphs(std::string &&formatted)
+  {
+    column += display_width_of(formatted, "", true);
+  }
+
+  void text(const std::string &text, TrueColor, TrueColor, const Styles &)
+  {
+    Place &place = places[current];
+    place.text_line = std::min(place.text_line, line);
+    auto const &format = row[current].format();
+    column += display_width_of(text, format.locale(), format.multi_bytes_character());
+  }
+
+  void spaces(size_t count, TrueColor, const Styles &)
+  {
+    column += count;
+  }
+
+  void begin_cell(size_t index)
+  {
+    current = index;
+    places[index].first = std::min(places[index].first, line);
+    places[index].last = line;
+    places[index].column = column;
+  }
+
+  void end_line()
+  {
+    line++;
+    column = 0;
+  }
+
+  std::vector<Place> places;
+  size_t line = 0;
+
+ private:
+  const Row &row;
+  size_t current = 0, column = 0;
+};
+} // namespace detail
+
+template <typename Output>
+void Row::__layout(Output &output, const StringFormatter &stringformatter, const BorderFormatter &borderformatter, const CornerFormatter &cornerformatter,
+                   size_t row_index, size_t total_rows, const TrueColor *backgrounds, const std::string_view *contents) const
+{
+  if (cells.empty()) {
+    return;
+  }
+
+  auto background_of = [&](size_t index) -> TrueColor {
+    if (backgrounds != nullptr && !backgrounds[index].none()) {
+      return backgrounds[index];
+    }
+    return cells[index]->background_color();
+  };
+
+  // Determine format directly based on row_index and total_rows
+  bool showbottom = (row_index == total_rows - 1);
+  bool is_middle_row = (row_index > 0 && row_index < total_rows - 1);
+
+  // Special case for single row in to_string<Row> context
+  if (total_rows <= 1) {
+    showbottom = true;
+    is_middle_row = false;
+  }
+
+  size_t max_height = 0;
+  std::vector<std::vector<std::string>> dumplines(cells.size());
+  for (size_t index = 0; index < cells.size(); index++) {
+    auto const &cell = cells[index];
+    if (contents != nullptr && contents[index].data() != nullptr) {
+      // drawn to the width of the cell by the table
+      dumplines[index].emplace_back(contents[index]);
+    } else if (cell->width() == 0) {
+      dumplines[index].push_back(cell->get());
+    } else {
+      dumplines[index] = wrap_lines(cell->get(), cell->width(), cell->format().locale(), cell->format().multi_bytes_character());
+    }
+    max_height = std::max(dumplines[index].size(), max_height);
+  }
+
+  auto border_line = [&](bool top) {
+    Which first = detail::corner_of(top, 0, cells.size(), is_middle_row, row_index == total_rows - 1, row_index == 0);
+    output.glyphs(cornerformatter(first, cells[0].get(), nullptr, nullptr, nullptr, nullptr, stringformatter));
+    for (size_t i = 0; i < cells.size(); i++) {
+      auto cell = cells[i].get();
+      auto left = i > 0 ? cells[i - 1].get() : nullptr;
+      auto right = (i + 1 < cells.size()) ? cells[i + 1].get() : nullptr;
+      auto &borders = cell->format().borders;
+      size_t size = borders.left.padding + cell->width() + borders.right.padding;
+      output.glyphs(borderformatter(top ? Which::top : Which::bottom, cell, left, right, nullptr, nullptr, size, stringformatter));
+      Which corner = detail::corner_of(top, i + 1, cells.size(), is_middle_row, row_index == total_rows - 1, row_index == 0);
+      output.glyphs(cornerformatter(corner, cell, nullptr, nullptr, nullptr, nullptr, stringformatter));
+    }
+    output.end_line();
+  };
+
+  auto pad_lines = [&](size_t count) {
+    for (size_t line = 0; line < count; line++) {
+      for (size_t i = 0; i < cells.size(); i++) {
+        auto cell = cells[i].get();
+        auto &borders = cell->format().borders;
+        auto left = i > 0 ? cells[i - 1].get() : nullptr;
+        auto right = (i + 1 < cells.size()) ? cells[i + 1].get() : nullptr;
+        output.glyphs(borderformatter(Which::left, cell, left, right, nullptr, nullptr, 1, stringformatter));
+        output.begin_cell(i);
+        output.spaces(borders.left.padding + cell->width() + borders.right.padding, background_of(i), {});
+      }
+      output.glyphs(borderformatter(Which::right, cells.back().get(), nullptr, nullptr, nullptr, nullptr, 1, stringformatter));
+      output.end_line();
+    }
+  };
+
+  if (cells[0]->format().borders.top.visiable) {
+    border_line(true);
+  }
+
+  // padding lines on top
+  pad_lines(cells[0]->format().borders.top.padding);
+
+  // border padding words padding sepeartor padding words padding sepeartor border
+  for (size_t i = 0; i < max_height; i++) {
+    output.glyphs(borderformatter(Which::left, cells[0].get(), nullptr, cells.size() >= 2 ? cells[1].get() : nullptr, nullptr, nullptr, 1, stringformatter));
+    for (size_t j = 0; j < cells.size(); j++) {
+      auto cell = cells[j].get();
+      auto left = j > 0 ? cells[j - 1].get() : nullptr;
+      auto right = (j + 1 < cells.size()) ? cells[j + 1].get() : nullptr;
+      auto background_color = background_of(j);
+      size_t cell_offset = 0, empty_lines = max_height - dumplines[j].size();
+      auto alignment = cell->format().align();
+      if (alignment & Align::bottom) {
+        cell_offset = empty_lines;
+      } else if (alignment & Align::top) {
+        cell_offset = 0;
+      } else { // DEFAULT: align center in vertical
+        cell_offset = empty_lines / 2;
+      }
+      output.begin_cell(j);
+      output.spaces(cell->format().borders.left.padding, background_color, {});
+      if (i < cell_offset || i >= dumplines[j].size() + cell_offset) {
+        output.spaces(cell->width(), background_color, cell->styles());
+      } else {
+        auto const &str = dumplines[j][i - cell_offset];
+        size_t width = cell->width();
+        size_t linesize = display_width_of(str, cell->format().locale(), cell->format().multi_bytes_character());
+        if (linesize >= width) {
+          output.text(str, cell->color(), background_color, cell->styles());
+        } else if (alignment & Align::hcenter) {
+          size_t remains = width - linesize;
+          output.spaces(remains / 2, background_color, {});
+          output.text(str, cell->color(), background_color, cell->styles());
+          output.spaces((remains + 1) / 2, background_color, {});
+        } else if (alignment & Align::right) {
+          output.spaces(width - linesize, background_color, {});
+          output.text(str, cell->color(), background_color, cell->styles());
+        } else { // DEFAULT: align left in horizontal
+          output.text(str, cell->color(), background_color, cell->styles());
+          output.spaces(width - linesize, background_color, {});
+        }
+      }
+      output.spaces(cell->format().borders.right.padding, background_color, {});
+      output.glyphs(borderformatter(Which::right, cell, left, right, nullptr, nullptr, 1, stringformatter));
+    }
+    output.end_line();
+  }
+
+  // padding lines on bottom
+  pad_lines(cells.back()->format().borders.bottom.padding);
+
+  if (showbottom && cells.back()->format().borders.bottom.visiable) {
+    border_line(false);
+  }
+}
+
+TABULATE_INLINE std::vector<std::string> Row::dump(StringFormatter stringformatter, BorderFormatter borderformatter, CornerFormatter cornerformatter,
+                                                   size_t row_index, size_t header_count, size_t total_rows, const TrueColor *backgrounds,
+                                                   const std::string_view *contents) const
+{
+  TABULATE_TRACE_SPAN("Row::dump", "row", row_index);
+  TABULATE_STATS_PHASE(dump_ns);
+  TABULATE_STATS_ADD(rows, 1);
+  TABULATE_STATS_ADD(cells, cells.size());
+  (void)header_count;
+
+  detail::LineBuilder output(stringformatter);
+  __layout(output, stringformatter, borderformatter, cornerformatter, row_index, total_rows, backgrounds, contents);
+  return std::move(output.lines);
+}
+
+TABULATE_INLINE size_t Row::dumped_size(StringFormatter stringformatter, BorderFormatter borderformatter, CornerFormatter cornerformatter,
+                                        size_t row_index, size_t total_rows, const TrueColor *backgrounds, const std::string_view *contents,
+                                        size_t &line_count) const
+{
+  detail::SizeCounter output(stringformatter);
+  __layout(output, stringformatter, borderformatter, cornerformatter, row_index, total_rows, backgrounds, contents);
+  line_count = output.lines;
+  return output.size;
+}
+
+// Column implementation
+// Basic access methods
+TABULATE_INLINE void Column::add(std::shared_ptr<Cell> cell)
+{
+  cells.push_back(cell);
+}
+
+TABULATE_INLINE BatchFormat Column::format()
+{
+  return BatchFormat(cells);
+}
+
+TABULATE_INLINE size_t Column::size()
+{
+  return cells.size();
+}
+
+TABULATE_INLINE Cell &Column::operator[](size_t index)
+{
+  return *cells[index];
+}
+
+TABULATE_INLINE const Cell &Column::operator[](size_t index) const
+{
+  return *cells[index];
+}
+
+// Format methods
+TABULATE_INLINE BatchFormat Column::format(size_t from, size_t to)
+{
+  std::vector<std::shared_ptr<Cell>> selected_cells;
+  for (size_t i = std::min(from, to); i <= std::max(from, to); i++) {
+    selected_cells.push_back(cells[i]);
+  }
+  return BatchFormat(selected_cells);
+}
+
+TABULATE_INLINE BatchFormat Column::format(std::initializer_list<std::tuple<size_t, size_t>> ranges)
+{
+  std::vector<std::shared_ptr<Cell>> selected_cells;
+  for (auto range : ranges) {
+    for (size_t i = std::min(std::get<0>(range), std::get<1>(range)); i < std::max(std::get<0>(range), std::get<1>(range)); i++) {
+      selected_cells.push_back(cells[i]);
+    }
+  }
+  return BatchFormat(selected_cells);
+}
+
+// Iterator methods
+TABULATE_INLINE Column::iterator Column::begin()
+{
+  return iterator(cells.begin());
+}
+
+TABULATE_INLINE Column::iterator Column::end()
+{
+  return iterator(cells.end());
+}
+
+TABULATE_INLINE Column::const_iterator Column::begin() const
+{
+  return const_iterator(cells.cbegin());
+}
+
+TABULATE_INLINE Column::const_iterator Column::end() const
+{
+  return const_iterator(cells.cend());
+}
+} // namespace tabulate
+
+namespace tabulate::xterm
+{
+TABULATE_INLINE bool has_truecolor()
+{
+  const char *term = getenv("TERM");
+  if (term == NULL) {
+    term = "";
+  };
+  static constexpr std::array<std::string_view, 4> terms_supported_truecolor = {"iterm", "linux", "xterm-truecolor", "xterm-256color"};
+
+  return std::find(terms_supported_truecolor.begin(), terms_supported_truecolor.end(), term) != terms_supported_truecolor.end();
+}
+
+TABULATE_INLINE ColorMode color_mode()
+{
+  // detected on first use rather than at static initialization
+  static const bool supported_truecolor = has_truecolor();
+  return supported_truecolor ? ColorMode::truecolor : ColorMode::basic;
+}
+
+namespace detail
+{
+// the escape sequence selecting colors and styles, without the reset
+TABULATE_INLINE const std::string &sgr_of(TrueColor foreground_color, TrueColor background_color, const Styles &styles, ColorMode mode)
+{
+  // escape sequences only depend on colors, styles and color depth, map and build each one once per thread
+  std::string key;
+  key += static_cast<char>(mode);
+  key.append(reinterpret_cast<const char *>(&foreground_color.hex), sizeof(foreground_color.hex));
+  key += static_cast<char>(foreground_color.color);
+  key.append(reinterpret_cast<const char *>(&background_color.hex), sizeof(background_color.hex));
+  key += static_cast<char>(background_color.color);
+  for (auto const &style : styles) {
+    key += static_cast<char>(style);
+  }
+
+  auto &cache = tabulate::detail::render_cache();
+  auto it = cache.sgrs.find(key);
+  if (it == cache.sgrs.end()) {
+    std::string applied;
+
+    auto rgb = [](TrueColor color) -> std::string {
+      auto v = color.RGB();
+      return std::to_string(std::get<0>(v)) + ":" + std::to_string(std::get<1>(v)) + ":" + std::to_string(std::get<2>(v));
+    };
+
+    auto style_code = [](Style style) -> unsigned int {
+      // @RESERVED
+      unsigned int i = to_underlying(style);
+      switch (i) {
+        case 0 ... 9: // 0 - 9
+          return i;
+        case 10 ... 18: // 21 - 29
+          return i + 11;
+        default:
+          return 0; // none, reset
+      }
+    };
+
+    if (mode == ColorMode::basic) {
+      applied += std::string("\033[");
+      applied += std::to_string(to_underlying(TrueColor::most_similar(foreground_color)) + 30) + ";";
+      applied += std::to_string(to_underlying(TrueColor::most_similar(background_color)) + 40) + ";";
+
+      if (styles.size() > 0) {
+        for (auto const &style : styles) {
+          // style: 0 - 9, 21 - 29
+          applied += std::to_string(style_code(style)) + ";";
+        }
+      }
+      applied[applied.size() - 1] = 'm';
+    } else {
+      if (!foreground_color.none()) {
+        if (mode == ColorMode::xterm256) {
+          // 256 colors: CSI 38 ; 5 ; n m
+          applied += "\033[38;5;" + std::to_string(TrueColor::most_similar_256(foreground_color)) + "m";
+        } else {
+          // TrueColor: CSI 38 : 2 : r : g : b m
+          applied += std::string("\033[38:2:") + rgb(foreground_color) + "m";
+        }
+      }
+
+      if (!background_color.none()) {
+        if (mode == ColorMode::xterm256) {
+          // CSI 48 ; 5 ; n m
+          applied += "\033[48;5;" + std::to_string(TrueColor::most_similar_256(background_color)) + "m";
+        } else {
+          // CSI 48 : 2 : r : g : b m
+          applied += std::string("\033[48:2:") + rgb(background_color) + "m";
+        }
+      }
+
+      if (styles.size() > 0) {
+        applied += "\033[";
+        for (auto const &style : styles) {
+          // style: 0 - 9, 21 - 29
+          applied += std::to_string(style_code(style)) + ";";
+        }
+        applied[applied.size() - 1] = 'm';
+      }
+    }
+
+    tabulate::detail::RenderCache::bound(cache.sgrs);
+    it = cache.sgrs.emplace(std::move(key), std::move(applied)).first;
+  }
+
+  return it->second;
+}
+} // namespace detail
+
+TABULATE_INLINE std::string colorize(const std::string &str, TrueColor foreground_color, TrueColor background_color, const Styles &styles, ColorMode mode)
+{
+  bool have = !foreground_color.none() || !background_color.none() || styles.size() != 0;
+  if (!have || mode == ColorMode::none) {
+    return str;
+  }
+
+  // the sequence and the reset
+  TABULATE_STATS_ADD(sgrs, 2);
+
+  auto const &sgr = detail::sgr_of(foreground_color, background_color, styles, mode);
+  std::string applied;
+  applied.reserve(sgr.size() + str.size() + 5);
+  applied += sgr;
+  applied += str;
+  applied += "\033[00m";
+
+  return applied;
+}
+
+TABULATE_INLINE std::string stringformatter(const std::string &str, TrueColor foreground_color, TrueColor background_color, const Styles &styles)
+{
+  return colorize(str, foreground_color, background_color, styles, color_mode());
+}
+
+} // namespace tabulate::xterm
+
+namespace tabulate
+{
+TABULATE_INLINE RenderProfile::RenderProfile() : color(xterm::color_mode()), unicode(true), no_color(false), isatty(true) {}
+
+TABULATE_INLINE RenderProfile RenderProfile::detect(int fd)
+{
+  RenderProfile profile;
+
+#if defined(__unix__) || defined(__unix) || defined(__APPLE__)
+  profile.isatty = ::isatty(fd) != 0;
+#else
+  (void)fd;
+#endif
+
+  // https://no-color.org: set and not empty
+  const char *no_color = getenv("NO_COLOR");
+  profile.no_color = no_color != NULL && no_color[0] != '\0';
+
+  const char *term = getenv("TERM");
+  const char *colorterm = getenv("COLORTERM");
+  if (term == NULL) {
+    term = "";
+  }
+  if (colorterm == NULL) {
+    colorterm = "";
+  }
+  if (xterm::has_truecolor() || strcmp(colorterm, "truecolor") == 0 || strcmp(colorterm, "24bit") == 0) {
+    profile.color = ColorMode::truecolor;
+  } else if (strstr(term, "256color") != NULL) {
+    profile.color = ColorMode::xterm256;
+  } else if (term[0] == '\0' || strcmp(term, "dumb") == 0) {
+    profile.color = ColorMode::none;
+  } else {
+    profile.color = ColorMode::basic;
+  }
+
+  // the first of LC_ALL, LC_CTYPE and LANG that is set decides the charset
+  const char *charset = "";
+  for (const char *name : {"LC_ALL", "LC_CTYPE", "LANG"}) {
+    const char *value = getenv(name);
+    if (value != NULL && value[0] != '\0') {
+      charset = value;
+      break;
+    }
+  }
+  std::string lowered(charset);
+  std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+  profile.unicode = lowered.find("utf-8") != std::string::npos || lowered.find("utf8") != std::string::npos;
+
+  return profile;
+}
+} // namespace tabulate
+
+namespace tabulate::xterm
+{
+
+namespace detail
+{
+// ASCII stand-in for a box drawing glyph (U+2500 - U+257F)
+TABULATE_INLINE char ascii_glyph(unsigned int codepoint)
+{
+  switch (codepoint) {
+    case 0x2500: case 0x2501: case 0x2504: case 0x2505: case 0x2508: case 0x2509: case 0x254C: case 0x254D:
+    case 0x2550: case 0x2574: case 0x2576: case 0x2578: case 0x257A: case 0x257C: case 0x257E:
+      return '-';
+    case 0x2502: case 0x2503: case 0x2506: case 0x2507: case 0x250A: case 0x250B: case 0x254E: case 0x254F:
+    case 0x2551: case 0x2575: case 0x2577: case 0x2579: case 0x257B: case 0x257D: case 0x257F:
+      return '|';
+    default:
+      return '+';
+  }
+}
+
+// the border or corner content of a format with box drawing glyphs (3 bytes in UTF-8: E2 94 80 -
+// E2 95 BF) replaced by ASCII, one character per glyph, so that it expands to the same width
+TABULATE_INLINE std::string ascii_glyphs(const std::string &str)
+{
+  std::string ascii;
+  ascii.reserve(str.size());
+  for (size_t i = 0; i < str.size(); i++) {
+    unsigned char c = str[i];
+    if (c == 0xE2 && i + 2 < str.size() && (static_cast<unsigned char>(str[i + 1]) == 0x94 || static_cast<unsigned char>(str[i + 1]) == 0x95)) {
+      unsigned int codepoint = 0x2000 | ((static_cast<unsigned char>(str[i + 1]) & 0x3F) << 6) | (static_cast<unsigned char>(str[i + 2]) & 0x3F);
+      ascii += ascii_glyph(codepoint);
+      i += 2;
+    } else {
+      ascii += str[i];
+    }
+  }
+  return ascii;
+}
+
+// borderformatter(), with the glyphs of the formats in ASCII when ascii is set
+TABULATE_INLINE std::string format_border(Which which, const Cell *self, const Cell *left, const Cell *right, const Cell *top, const Cell *bottom,
+                                          size_t expected_size, const StringFormatter &stringformatter, bool ascii)
+{
+  auto glyphs_of = [ascii](const std::string &content) { return ascii ? ascii_glyphs(content) : content; };
+  // border glyphs are multi-byte whatever the content of the cell is
+#define TRY_GET(pattern, which, which_reverse)                                                                             \
+  if (self->format().pattern.which.visiable) {                                                                             \
+    auto it = self->format().pattern.which;                                                                                \
+    return stringformatter(expand_to_size(glyphs_of(it.content), expected_size, true), it.color, it.background_color, {}); \
+  } else if (which && which->format().pattern.which_reverse.visiable) {                                                    \
+    auto it = which->format().pattern.which_reverse;                                                                       \
+    return stringformatter(expand_to_size(glyphs_of(it.content), expected_size, true), it.color, it.background_color, {}); \
+  }
+  if (which == Which::top) {
+    TRY_GET(borders, top, bottom);
+  } else if (which == Which::bottom) {
+    TRY_GET(borders, bottom, top);
+  } else if (which == Which::left) {
+    TRY_GET(borders, left, right);
+  } else if (which == Which::right) {
+    TRY_GET(borders, right, left);
+  } else if (which == Which::cross) {
+    // Cross junction with all four directions
+    TRY_GET(borders, left, right); // Default to using left-right direction
+  } else if (which == Which::bottom_middle) {
+    // T-shape junction pointing north (┴)
+    TRY_GET(borders, top, bottom);
+  } else if (which == Which::top_middle) {
+    // T-shape junction pointing south (┬)
+    TRY_GET(borders, bottom, top);
+  } else if (which == Which::middle_right) {
+    // T-shape junction pointing west (┤)
+    TRY_GET(borders, left, right);
+  } else if (which == Which::middle_left) {
+    // T-shape junction pointing east (├)
+    TRY_GET(borders, right, left);
+  }
+#undef TRY_GET
+  return "";
+}
+
+// cornerformatter(), with the glyphs of the formats and the default junctions in ASCII when ascii is set
+TABULATE_INLINE std::string format_corner(Which which, const Cell *self, const Cell *top_left, const Cell *top_right, const Cell *bottom_left,
+                                          const Cell *bottom_right, const StringFormatter &stringformatter, bool ascii)
+{
+  auto glyphs_of = [ascii](const std::string &content) { return ascii ? ascii_glyphs(content) : content; };
+#define TRY_GET(pattern, which, which_reverse)                                        \
+  if (self->format().pattern.which.visiable) {                                        \
+    auto it = self->format().pattern.which;                                           \
+    return stringformatter(glyphs_of(it.content), it.color, it.background_color, {}); \
+  } else if (which && which->format().pattern.which_reverse.visiable) {               \
+    auto it = which->format().pattern.which_reverse;                                  \
+    return stringformatter(glyphs_of(it.content), it.color, it.background_color, {}); \
+  }
+
+  // Junction corners - prioritize specialized corner members
+  if (which == Which::cross) {
+    // Cross junction with all four directions - use dedicated cross member
+    if (self->format().corners.cross.visiable) {
+      auto it = self->format().corners.cross;
+      return stringformatter(glyphs_of(it.content), it.color, it.background_color, {});
+    }
+  } else if (which == Which::bottom_middle) {
+    // T-shape junction pointing north (┴) - use dedicated bottom_middle member
+    if (self->format().corners.bottom_middle.visiable) {
+      auto it = self->format().corners.bottom_middle;
+      return stringformatter(glyphs_of(it.content), it.color, it.background_color, {});
+    }
+  } else if (which == Which::top_middle) {
+    // T-shape junction pointing south (┬) - use dedicated top_middle member
+    if (self->format().corners.top_middle.visiable) {
+      auto it = self->format().corners.top_middle;
+      return stringformatter(glyphs_of(it.content), it.color, it.background_color, {});
+    }
+  } else if (which == Which::middle_right) {
+    // T-shape junction pointing west (┤) - use dedicated middle_right member
+    if (self->format().corners.middle_right.visiable) {
+      auto it = self->format().corners.middle_right;
+      return stringformatter(glyphs_of(it.content), it.color, it.background_color, {});
+    }
+  } else if (which == Which::middle_left) {
+    // T-shape junction pointing east (├) - use dedicated middle_left member
+    if (self->format().corners.middle_left.visiable) {
+      auto it = self->format().corners.middle_left;
+      return stringformatter(glyphs_of(it.content), it.color, it.background_color, {});
+    }
+  }
+
+  // Basic corners as fallback
+  if (which == Which::top_left || which == Which::cross || which == Which::top_middle || which == Which::middle_left) {
+    TRY_GET(corners, top_left, bottom_right);
+  } else if (which == Which::top_right || which == Which::middle_right) {
+    TRY_GET(corners, top_right, bottom_left);
+  } else if (which == Which::bottom_left || which == Which::bottom_middle) {
+    TRY_GET(corners, bottom_left, top_right);
+  } else if (which == Which::bottom_right) {
+    TRY_GET(corners, bottom_right, top_left);
+  }
+
+#undef TRY_GET
+
+  // Default fallback characters when no specific junction is found
+  if (which == Which::cross) {
+    return stringformatter(glyphs_of(std::string(symbols::cross)), Color::none, Color::none, {});
+  } else if (which == Which::bottom_middle) {
+    return stringformatter(glyphs_of(std::string(symbols::div_down)), Color::none, Color::none, {});
+  } else if (which == Which::top_middle) {
+    return stringformatter(glyphs_of(std::string(symbols::div_up)), Color::none, Color::none, {});
+  } else if (which == Which::middle_right) {
+    return stringformatter(glyphs_of(std::string(symbols::div_right)), Color::none, Color::none, {});
+  } else if (which == Which::middle_left) {
+    return stringformatter(glyphs_of(std::string(symbols::div_left)), Color::none, Color::none, {});
+  }
+
+  return " ";
+}
+} // namespace detail
+
+TABULATE_INLINE std::string borderformatter(Which which, const Cell *self, const Cell *left, const Cell *right, const Cell *top, const Cell *bottom,
+                                            size_t expected_size, StringFormatter stringformatter)
+{
+  return detail::format_border(which, self, left, right, top, bottom, expected_size, stringformatter, false);
+}
+
+TABULATE_INLINE std::string cornerformatter(Which which, const Cell *self, const Cell *top_left, const Cell *top_right, const Cell *bottom_left,
+                                            const Cell *bottom_right, StringFormatter stringformatter)
+{
+  return detail::format_corner(which, self, top_left, top_right, bottom_left, bottom_right, stringformatter, false);
+}
+} // namespace tabulate::xterm
+
+namespace tabulate
+{
+TABULATE_INLINE void Table::set_title(std::string title)
+{
+  this->title = std::move(title);
+}
+
+// Table class implementation
+// Basic methods
+TABULATE_INLINE BatchFormat Table::format()
+{
+  return BatchFormat(cells);
+}
+
+TABULATE_INLINE Row &Table::add()
+{
+  Row &row = __add_row();
+  __on_add_auto_update();
+
+  return row;
+}
+
+TABULATE_INLINE Row &Table::operator[](size_t index)
+{
+  if (index >= rows.size()) {
+    size_t size = index + 1 - rows.size();
+    for (size_t i = 0; i < size; i++) {
+      add();
+    }
+  }
+  return *rows[index];
+}
+
+TABULATE_INLINE size_t Table::size()
+{
+  return rows.size();
+}
+
+// Iterator methods
+TABULATE_INLINE Table::iterator Table::begin()
+{
+  return iterator(rows.begin());
+}
+
+TABULATE_INLINE Table::iterator Table::end()
+{
+  return iterator(rows.end());
+}
+
+TABULATE_INLINE Table::const_iterator Table::begin() const
+{
+  return const_iterator(rows.cbegin());
+}
+
+TABULATE_INLINE Table::const_iterator Table::end() const
+{
+  return const_iterator(rows.cend());
+}
+
+// Column and layout methods
+TABULATE_INLINE Column Table::column(size_t index)
+{
+  TABULATE_TRACE_SPAN("Table::column", "column", index);
+  Column column;
+  for (auto &row : rows) {
+    if (row->size() <= index) {
+      size_t size = index - row->size() + 1;
+      for (size_t i = 0; i < size; i++) {
+        row->add("");
+      }
+    }
+    column.add(row->cell(index));
+  }
+
+  return column;
+}
+
+namespace detail
+{
+// vectors of pairs sorted by key stand in for maps of the few decorated columns
+template <typename Entries, typename Key>
+auto lower_entry(Entries &entries, const Key &key) -> decltype(entries.begin())
+{
+  return std::lower_bound(entries.begin(), entries.end(), key, [](const auto &entry, const Key &key) { return entry.first < key; });
+}
+
+template <typename Entries, typename Key>
+auto find_entry(Entries &entries, const Key &key) -> decltype(&entries.begin()->second)
+{
+  auto it = lower_entry(entries, key);
+  return it != entries.end() && it->first == key ? &it->second : nullptr;
+}
+
+template <typename Key, typename T>
+T &assign_entry(std::vector<std::pair<Key, T>> &entries, const Key &key, T value)
+{
+  auto it = lower_entry(entries, key);
+  if (it != entries.end() && it->first == key) {
+    it->second = std::move(value);
+  } else {
+    it = entries.emplace(it, key, std::move(value));
+  }
+  return it->second;
+}
+} // namespace detail
+
+TABULATE_INLINE Table &Table::colormap(size_t index, ColorMap colormap)
+{
+  detail::assign_entry(colormaps, index, std::move(colormap));
+
+  return *this;
+}
+
+TABULATE_INLINE Table &Table::bar(size_t index, double min, double max)
+{
+  detail::assign_entry(bars, index, BarRange{min, max, false});
+
+  return *this;
+}
+
+TABULATE_INLINE Table &Table::bar(size_t index)
+{
+  detail::assign_entry(bars, index, BarRange{0, 0, true});
+
+  return *this;
+}
+
+TABULATE_INLINE Table &Table::progress(size_t index)
+{
+  return bar(index, 0, 100);
+}
+
+TABULATE_INLINE size_t Table::column_size() const
+{
+  size_t max_size = 0;
+  for (auto const &row : rows) {
+    max_size = std::max(max_size, row->size());
+  }
+  return max_size;
+}
+
+TABULATE_INLINE size_t Table::width() const
+{
+  return cached_width;
+}
+
+// Utility methods
+TABULATE_INLINE int Table::merge(std::tuple<int, int> from, std::tuple<int, int> to)
+{
+  auto fx = std::get<0>(from), tx = std::get<0>(to);
+  auto fy = std::get<1>(from), ty = std::get<1>(to);
+  if (fx != tx && fy != ty) {
+    merges.push_back(std::tuple<int, int, int, int>(fx, fy, tx, ty));
+  }
+
+  return 0;
+}
+
+// Output formatting methods
+TABULATE_INLINE std::string Table::xterm(bool disable_color) const
+{
+  std::string exported;
+  StringSink sink(exported);
+  xterm(sink, disable_color);
+
+  return exported;
+}
+
+TABULATE_INLINE void Table::xterm(Sink &sink, bool disable_color) const
+{
+  RenderProfile profile;
+  if (disable_color) {
+    profile.color = ColorMode::none;
+  }
+  xterm(sink, profile);
+}
+
+TABULATE_INLINE std::string Table::xterm(ColorMode mode) const
+{
+  std::string exported;
+  StringSink sink(exported);
+  xterm(sink, mode);
+
+  return exported;
+}
+
+TABULATE_INLINE void Table::xterm(Sink &sink, ColorMode mode) const
+{
+  RenderProfile profile;
+  profile.color = mode;
+  xterm(sink, profile);
+}
+
+TABULATE_INLINE std::string Table::xterm(const RenderProfile &profile) const
+{
+  std::string exported;
+  StringSink sink(exported);
+  xterm(sink, profile);
+
+  return exported;
+}
+
+namespace detail
+{
+// formatters generating only what the profile asks for
+struct ProfileFormatters {
+  explicit ProfileFormatters(const RenderProfile &profile)
+  {
+    ColorMode mode = profile.colors();
+    stringformatter = [mode](const std::string &str, TrueColor foreground_color, TrueColor background_color, const Styles &styles) -> std::string {
+      return tabulate::xterm::colorize(str, foreground_color, background_color, styles, mode);
+    };
+    if (profile.unicode) {
+      borderformatter = tabulate::xterm::borderformatter;
+      cornerformatter = tabulate::xterm::cornerformatter;
+    } else {
+      // the glyphs are chosen in ASCII, the contents of the cells are kept
+      borderformatter = [](Which which, const Cell *self, const Cell *left, const Cell *right, const Cell *top, const Cell *bottom, size_t expected_size,
+                           StringFormatter stringformatter) -> std::string {
+        return tabulate::xterm::detail::format_border(which, self, left, right, top, bottom, expected_size, stringformatter, true);
+      };
+      cornerformatter = [](Which which, const Cell *self, const Cell *top_left, const Cell *top_right, const Cell *bottom_left, const Cell *bottom_right,
+                           StringFormatter stringformatter) -> std::string {
+        return tabulate::xterm::detail::format_corner(which, self, top_left, top_right, bottom_left, bottom_right, stringformatter, true);
+      };
+    }
+  }
+
+  StringFormatter stringformatter;
+  BorderFormatter borderformatter;
+  CornerFormatter cornerformatter;
+};
+
+// the number a cell starts with, NaN for text
+TABULATE_INLINE double value_of(const std::string &text)
+{
+  const char *begin = text.c_str();
+  char *end = nullptr;
+  double value = strtod(begin, &end);
+  return end == begin ? std::numeric_limits<double>::quiet_NaN() : value;
+}
+
+// length of the bar of a value in eighths of a character, @p max fills @p width characters
+TABULATE_INLINE size_t bar_eighths(double value, double min, double max, size_t width)
+{
+  double ratio = max > min ? (value - min) / (max - min) : (value > min ? 1 : 0);
+  return static_cast<size_t>(std::lround(std::min(std::max(ratio, 0.0), 1.0) * static_cast<double>(width * 8)));
+}
+
+TABULATE_INLINE size_t bar_bytes(size_t eighths)
+{
+  return eighths / 8 * symbols::horizontal_eighths[8].size() + symbols::horizontal_eighths[eighths % 8].size();
+}
+
+// appends a bar and returns a view of it, the capacity of @p glyphs must hold it
+TABULATE_INLINE std::string_view append_bar(std::string &glyphs, size_t eighths)
+{
+  size_t offset = glyphs.size();
+  for (size_t i = 0; i < eighths / 8; i++) {
+    glyphs += symbols::horizontal_eighths[8];
+  }
+  glyphs += symbols::horizontal_eighths[eighths % 8];
+  return std::string_view(glyphs.data() + offset, glyphs.size() - offset);
+}
+} // namespace detail
+
+TABULATE_INLINE void Table::xterm(Sink &sink, const RenderProfile &profile) const
+{
+  TABULATE_TRACE_SPAN("Table::xterm", "rows", rows.size());
+  // lines are separated, not terminated, by NEWLINE
+  bool first_line = true;
+  auto emit = [&](std::string &&line) {
+    TABULATE_STATS_PHASE(join_ns);
+    TABULATE_STATS_ADD(output_bytes, first_line ? line.size() : NEWLINE.size() + line.size());
+    if (!first_line) {
+      sink.write(NEWLINE);
+    }
+    sink.write_owned(std::move(line));
+    first_line = false;
+  };
+
+  // add title
+  if (!title.empty() && rows.size() > 0) {
+    emit(std::string((__width() - title.size()) / 2, ' ') + title);
+  }
+
+  detail::ProfileFormatters formatters(profile);
+  std::vector<std::vector<TrueColor>> backgrounds;
+  std::vector<std::vector<std::string_view>> contents;
+  std::string glyphs;
+  {
+    TABULATE_STATS_PHASE(layout_ns);
+    backgrounds = __backgrounds();
+    contents = __bars(glyphs);
+  }
+
+  // Determine number of header rows (typically 1)
+  size_t header_count = 1;
+  size_t total_rows = rows.size();
+
+  // add header
+  if (rows.size() > 0) {
+    const auto &header = *rows[0];
+    // Pass row_index=0, header_count, and total_rows instead of boolean flags
+    auto lines = header.dump(formatters.stringformatter, formatters.borderformatter, formatters.cornerformatter, 0, header_count, total_rows);
+    for (auto &line : lines) {
+      emit(std::move(line));
+    }
+  }
+
+  // add table content
+  for (size_t i = 1; i < rows.size(); i++) {
+    auto const &row = *rows[i];
+    // Pass row_index=i, header_count, and total_rows instead of is_middle flag
+    auto lines = row.dump(formatters.stringformatter, formatters.borderformatter, formatters.cornerformatter, i, header_count, total_rows,
+                          i < backgrounds.size() && !backgrounds[i].empty() ? backgrounds[i].data() : nullptr,
+                          i < contents.size() && !contents[i].empty() ? contents[i].data() : nullptr);
+    for (auto &line : lines) {
+      emit(std::move(line));
+    }
+  }
+}
+
+TABULATE_INLINE void Table::xterm(RowSource &source, Sink &sink, size_t sample, const RenderProfile &profile) const
+{
+  TABULATE_TRACE_SPAN("Table::xterm(RowSource)", "sample", sample);
+  bool first_line = true;
+  auto emit = [&](std::string &&line) {
+    TABULATE_STATS_PHASE(join_ns);
+    TABULATE_STATS_ADD(output_bytes, first_line ? line.size() : NEWLINE.size() + line.size());
+    if (!first_line) {
+      sink.write(NEWLINE);
+    }
+    sink.write_owned(std::move(line));
+    first_line = false;
+  };
+
+  detail::ProfileFormatters formatters(profile);
+
+  std::deque<std::unique_ptr<Row>> pending;
+  std::vector<size_t> widths;
+  std::vector<std::pair<size_t, ColorMap>> fitted;
+  auto ranges = bars;
+  bool exhausted = false;
+  {
+    TABULATE_STATS_PHASE(layout_ns);
+
+    // rows of the table itself (the header) are copied, their widths may change below
+    for (auto const &row : rows) {
+      std::unique_ptr<Row> copied(new Row());
+      for (size_t j = 0; j < row->size(); j++) {
+        (*copied)[j];
+        copied->cell(j) = std::make_shared<Cell>((*row)[j]);
+      }
+      pending.push_back(std::move(copied));
+    }
+
+    if (rows.size() > 0) {
+      for (auto const &cell : *rows[0]) {
+        widths.push_back(cell.width());
+      }
+    }
+
+    // buffer a few rows up front to estimate the column widths, at least one without a header to take them from
+    if (widths.empty()) {
+      sample = std::max<size_t>(sample, 1);
+    }
+    for (size_t i = 0; i < sample && !exhausted; i++) {
+      std::unique_ptr<Row> row(new Row());
+      if (source.next(*row)) {
+        for (size_t j = 0; j < row->size(); j++) {
+          if (j >= widths.size()) {
+            widths.push_back(0);
+          }
+          widths[j] = std::max(widths[j], (*row)[j].width());
+        }
+        pending.push_back(std::move(row));
+      } else {
+        exhausted = true;
+      }
+    }
+
+    // streamed rows are colored on the range of the rows buffered up front
+    for (auto const &entry : colormaps) {
+      std::vector<double> values;
+      for (size_t i = rows.size(); i < pending.size(); i++) {
+        if (entry.first < pending[i]->size()) {
+          values.push_back(detail::value_of((*pending[i])[entry.first].get()));
+        }
+      }
+      fitted.emplace_back(entry.first, entry.second.fit(values.data(), values.size()));
+    }
+    for (auto &entry : ranges) {
+      for (size_t i = rows.size(); entry.second.fitted && i < pending.size(); i++) {
+        if (entry.first < pending[i]->size()) {
+          double value = detail::value_of((*pending[i])[entry.first].get());
+          entry.second.max = std::isnan(value) ? entry.second.max : std::max(entry.second.max, value);
+        }
+      }
+    }
+  }
+
+  auto next = [&]() -> std::unique_ptr<Row> {
+    while (true) {
+      std::unique_ptr<Row> row;
+      if (!pending.empty()) {
+        row = std::move(pending.front());
+        pending.pop_front();
+      } else if (!exhausted) {
+        row.reset(new Row());
+        if (!source.next(*row)) {
+          exhausted = true;
+          return nullptr;
+        }
+      } else {
+        return nullptr;
+      }
+
+      // lay the row out in the columns of the table
+      for (size_t j = 0; j < widths.size(); j++) {
+        (*row)[j].format().width(widths[j]);
+      }
+      if (row->size() > 0) {
+        return row;
+      }
+    }
+  };
+
+  std::unique_ptr<Row> current = next();
+
+  // add title
+  if (!title.empty() && current) {
+    emit(std::string((__width(*current) - title.size()) / 2, ' ') + title);
+  }
+
+  // one row of lookahead tells whether the current row is the last one, the rows of the table are the header
+  size_t header_count = rows.size();
+  for (size_t i = 0; current; i++) {
+    std::unique_ptr<Row> upcoming = next();
+    size_t total_rows = upcoming ? i + 2 : i + 1;
+
+    std::vector<TrueColor> backgrounds;
+    if (i >= header_count && !fitted.empty()) {
+      backgrounds.resize(current->size());
+      for (auto const &entry : fitted) {
+        if (entry.first < current->size()) {
+          backgrounds[entry.first] = entry.second(detail::value_of((*current)[entry.first].get()));
+        }
+      }
+    }
+
+    std::vector<std::string_view> contents;
+    std::string glyphs;
+    if (i >= header_count && !ranges.empty()) {
+      contents.resize(current->size());
+      size_t size = 0;
+      for (auto const &entry : ranges) {
+        size += entry.first < current->size() ? detail::bar_bytes(8 * (*current)[entry.first].width()) : 0;
+      }
+      glyphs.reserve(size);
+      for (auto const &entry : ranges) {
+        double value = entry.first < current->size() ? detail::value_of((*current)[entry.first].get()) : std::numeric_limits<double>::quiet_NaN();
+        if (!std::isnan(value)) {
+          contents[entry.first] = detail::append_bar(glyphs, detail::bar_eighths(value, entry.second.min, entry.second.max, (*current)[entry.first].width()));
+        }
+      }
+    }
+
+    auto lines = current->dump(formatters.stringformatter, formatters.borderformatter, formatters.cornerformatter, i, header_count, total_rows,
+                               backgrounds.empty() ? nullptr : backgrounds.data(), contents.empty() ? nullptr : contents.data());
+    for (auto &line : lines) {
+      emit(std::move(line));
+    }
+
+    current = std::move(upcoming);
+  }
+}
+
+TABULATE_INLINE std::string Table::xterm(size_t maxlines, bool keep_row_in_one_page) const
+{
+  TABULATE_TRACE_SPAN("Table::xterm(maxlines)", "rows", rows.size());
+  std::string exported;
+  if (!title.empty() && rows.size() > 0) {
+    size_t size = width();
+    if (size > title.size()) {
+      exported = std::string((size - title.size()) / 2, ' ') + title;
+      exported += NEWLINE;
+    } else {
+      auto lines = wrap_lines(title, size, "", true);
+      for (auto line : lines) {
+        exported += line;
+        exported += NEWLINE;
+      }
+    }
+  }
+
+  // Determine number of header rows (typically 1)
+  size_t header_count = 1;
+  size_t total_rows = rows.size();
+
+  // add header
+  size_t hlines = 0;
+  std::string header;
+  if (rows.size() > 0) {
+    const auto &_header = *rows[0];
+    // Pass row_index=0, header_count, and total_rows
+    auto lines =
+        _header.dump(tabulate::xterm::stringformatter, tabulate::xterm::borderformatter, tabulate::xterm::cornerformatter, 0, header_count, total_rows);
+    for (auto const &line : lines) {
+      hlines++;
+      header += line;
+      header += NEWLINE;
+    }
+  }
+  if (maxlines <= hlines) { // maxlines too small
+    return header + "===== <Inappropriate Max Lines for PageBreak> ====";
+  }
+
+  exported += header;
+  size_t nlines = hlines;
+  auto backgrounds = __backgrounds();
+  std::string glyphs;
+  auto contents = __bars(glyphs);
+  for (size_t i = 1; i < rows.size(); i++) {
+    auto const &row = *rows[i];
+    // Pass row_index=i, header_count, and total_rows
+    auto lines = row.dump(tabulate::xterm::stringformatter, tabulate::xterm::borderformatter, tabulate::xterm::cornerformatter, i, header_count, total_rows,
+                          i < backgrounds.size() && !backgrounds[i].empty() ? backgrounds[i].data() : nullptr,
+                          i < contents.size() && !contents[i].empty() ? contents[i].data() : nullptr);
+
+    if (keep_row_in_one_page) {
+      size_t rowlines = lines.size();
+      if (hlines + rowlines > maxlines) {
+        return exported + "===== <Inappropriate Max Lines for PageBreak> ====";
+      }
+      if (nlines + rowlines > maxlines) {
+        if (exported.size() >= NEWLINE.size()) {
+          exported.erase(exported.size() - NEWLINE.size(), NEWLINE.size()); // pop last NEWLINE
+        }
+        exported += "\x0c" + header;
+        nlines = hlines;
+      }
+      nlines += rowlines;
+      for (auto const &line : lines) {
+        exported += line;
+        exported += NEWLINE;
+      }
+    } else {
+      for (auto line : lines) {
+        if (nlines >= maxlines) {
+          if (exported.size() >= NEWLINE.size()) {
+            exported.erase(exported.size() - NEWLINE.size(), NEWLINE.size()); // pop last NEWLINE
+          }
+          exported += "\x0c" + header;
+          nlines = hlines;
+        }
+        nlines++;
+        exported += line;
+      }
+    }
+  }
+
+  TABULATE_STATS_ADD(output_bytes, exported.size());
+  return exported;
+}
+
+namespace detail
+{
+// appends the opening tag carrying the colors and styles of a cell, nothing if it has none
+TABULATE_INLINE void append_markdown_span(std::string &applied, const Cell &cell)
+{
+  auto styles = cell.format().styles();
+  auto foreground_color = cell.format().color();
+  auto background_color = cell.format().background_color();
+  bool have = !foreground_color.none() || !background_color.none() || styles.size() != 0;
+
+  if (have) {
+    applied += "<span style=\"";
+
+    if (!foreground_color.none()) {
+      // color: <color>
+      applied += "color:" + to_string(foreground_color) + ";";
+    }
+
+    if (!background_color.none()) {
+      // color: <color>
+      applied += "background-color:" + to_string(background_color) + ";";
+    }
+
+    for (auto const &style : styles) {
+      switch (style) {
+        case Style::bold:
+          applied += "font-weight:bold;";
+          break;
+        case Style::italic:
+          applied += "font-style:italic;";
+          break;
+        // text-decoration: none|underline|overline|line-through|blink
+        case Style::crossed:
+          applied += "text-decoration:line-through;";
+          break;
+        case Style::underline:
+          applied += "text-decoration:underline;";
+          break;
+        case Style::blink:
+          applied += "text-decoration:blink;";
+          break;
+        default:
+          // unsupported, do nothing
+          break;
+      }
+    }
+    applied += "\">";
+  }
+}
+
+// appends @p text with every @p from replaced like replace_all() does
+TABULATE_INLINE void append_replaced(std::string &out, const std::string &text, std::string_view from, std::string_view to)
+{
+  size_t start = 0;
+  for (size_t pos = text.find(from); pos != std::string::npos; pos = text.find(from, start)) {
+    out.append(text, start, pos - start);
+    out += to;
+    start = pos + from.size();
+  }
+  out.append(text, start, std::string::npos);
+}
+
+// occurrences of @p pattern in @p text, counted like replace_all() replaces them
+TABULATE_INLINE size_t count_of(const std::string &text, std::string_view pattern)
+{
+  size_t count = 0;
+  for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size())) {
+    count++;
+  }
+  return count;
+}
+} // namespace detail
+
+TABULATE_INLINE std::string Table::markdown() const
+{
+  std::string exported;
+  exported.reserve(rendered_size(Exporter::markdown));
+  StringSink sink(exported);
+  markdown(sink);
+
+  return exported;
+}
+
+TABULATE_INLINE void Table::markdown(Sink &sink) const
+{
+  TABULATE_TRACE_SPAN("Table::markdown", "rows", rows.size());
+  TABULATE_STATS_PHASE(join_ns);
+
+  // a row at a time through one buffer, rows are separated by NEWLINE
+  std::string line;
+  for (size_t i = 0; i < rows.size(); i++) {
+    TABULATE_STATS_ADD(rows, 1);
+    TABULATE_STATS_ADD(cells, rows[i]->size());
+    line.clear();
+    if (i > 0) {
+      line += NEWLINE;
+    }
+    line += "| ";
+    for (auto const &cell : *rows[i]) {
+      size_t start = line.size();
+      detail::append_markdown_span(line, cell);
+      bool span = line.size() > start;
+      detail::append_replaced(line, cell.get(), NEWLINE, "<br>");
+      if (span) {
+        line += "</span>";
+      }
+      line += " | ";
+    }
+
+    if (i == 0) {
+      // add alignentment
+      line += NEWLINE;
+      line += "|";
+      for (auto const &cell : *rows[0]) {
+        switch (cell.align()) {
+          case Align::left:
+            line += " :--";
+            break;
+          case Align::right:
+            line += " --:";
+            break;
+          case Align::center:
+            line += " :-:";
+            break;
+          default:
+            line += " ---";
+            break;
+        }
+        line += " |";
+      }
+    }
+
+    TABULATE_STATS_ADD(output_bytes, line.size());
+    sink.write(line);
+  }
+}
+
+TABULATE_INLINE std::string Table::latex(size_t indentation) const
+{
+  std::string exported;
+  exported.reserve(rendered_size(Exporter::latex, RenderProfile(), indentation));
+  StringSink sink(exported);
+  latex(sink, indentation);
+
+  return exported;
+}
+
+TABULATE_INLINE void Table::latex(Sink &sink, size_t indentation) const
+{
+  TABULATE_TRACE_SPAN("Table::latex", "rows", rows.size());
+  TABULATE_STATS_PHASE(join_ns);
+  std::string line = "\\begin{table}[ht]";
+  line += NEWLINE;
+  if (!title.empty()) {
+    line += "\\caption{" + title + "}";
+    line += NEWLINE;
+    line += "\\centering"; // used for centering table
+    line += NEWLINE;
+  }
+  line += "\\begin{tabular}";
+
+  // add alignment header
+  {
+    line += "{";
+    for (auto &cell : *rows[0]) {
+      if (cell.align() & Align::left) {
+        line += 'l';
+      } else if (cell.align() & Align::hcenter) {
+        line += 'c';
+      } else if (cell.align() & Align::right) {
+        line += 'r';
+      }
+    }
+    line += "}";
+    line += NEWLINE;
+  }
+  line += "\\hline\\hline"; // %inserts double horizontal lines
+  line += NEWLINE;
+  TABULATE_STATS_ADD(output_bytes, line.size());
+  sink.write(line);
+
+  // iterate content and put text into the table, a row at a time through one buffer
+  for (size_t i = 0; i < rows.size(); i++) {
+    auto &row = *rows[i];
+    TABULATE_STATS_ADD(rows, 1);
+    TABULATE_STATS_ADD(cells, row.size());
+
+    // apply row content indentation
+    line.assign(indentation, ' ');
+
+    for (size_t j = 0; j < row.size(); j++) {
+      auto const &cell = row[j];
+      detail::append_replaced(line, cell.get(), "#", "\\#");
+      if (!(cell.format().background_color().none())) {
+        line += "\\cellcolor[HTML]{" + to_string(cell.format().background_color()) + "} ";
+      }
+      line += (j < row.size() - 1) ? " & " : " \\\\";
+    }
+    line += NEWLINE;
+    if (i == 0) {
+      line += "\\hline";
+      line += NEWLINE;
+    }
+    TABULATE_STATS_ADD(output_bytes, line.size());
+    sink.write(line);
+  }
+  line = "\\hline";
+  line += NEWLINE;
+  line += "\\end{tabular}";
+  line += NEWLINE;
+  line += "\\end{table}";
+  TABULATE_STATS_ADD(output_bytes, line.size());
+  sink.write(line);
+}
+
+TABULATE_INLINE size_t Table::rendered_size(Exporter exporter, const RenderProfile &profile, size_t indentation) const
+{
+  TABULATE_TRACE_SPAN("Table::rendered_size", "rows", rows.size());
+  size_t size = 0;
+  if (exporter == Exporter::xterm) {
+    // lines are separated, not terminated, by NEWLINE
+    size_t lines = 0;
+    if (!title.empty() && rows.size() > 0) {
+      size += (__width() - title.size()) / 2 + title.size();
+      lines++;
+    }
+
+    detail::ProfileFormatters formatters(profile);
+    auto backgrounds = __backgrounds();
+    std::string glyphs;
+    auto contents = __bars(glyphs);
+    for (size_t i = 0; i < rows.size(); i++) {
+      size_t count = 0;
+      size += rows[i]->dumped_size(formatters.stringformatter, formatters.borderformatter, formatters.cornerformatter, i, rows.size(),
+                                   i < backgrounds.size() && !backgrounds[i].empty() ? backgrounds[i].data() : nullptr,
+                                   i < contents.size() && !contents[i].empty() ? contents[i].data() : nullptr, count);
+      lines += count;
+    }
+    return size + (lines > 0 ? (lines - 1) * NEWLINE.size() : 0);
+  }
+
+  if (exporter == Exporter::markdown) {
+    std::string span;
+    for (size_t i = 0; i < rows.size(); i++) {
+      size += 2 + NEWLINE.size(); // "| " and the line break
+      for (auto const &cell : *rows[i]) {
+        span.clear();
+        detail::append_markdown_span(span, cell);
+        size += span.size() + cell.get().size() + detail::count_of(cell.get(), NEWLINE) * (4 - NEWLINE.size()) + (span.empty() ? 0 : 7) + 3;
+      }
+      if (i == 0) {
+        size += 1 + 6 * rows[0]->size() + NEWLINE.size(); // "|" and " :-- |" per column
+      }
+    }
+    return size >= NEWLINE.size() ? size - NEWLINE.size() : size;
+  }
+
+  // latex
+  size += std::string_view("\\begin{table}[ht]").size() + NEWLINE.size();
+  if (!title.empty()) {
+    size += std::string_view("\\caption{}").size() + title.size() + NEWLINE.size() + std::string_view("\\centering").size() + NEWLINE.size();
+  }
+  size += std::string_view("\\begin{tabular}{}").size() + NEWLINE.size();
+  if (!rows.empty()) {
+    for (auto const &cell : *rows[0]) {
+      size += (cell.align() & (Align::left | Align::hcenter | Align::right)) ? 1 : 0;
+    }
+  }
+  size += std::string_view("\\hline\\hline").size() + NEWLINE.size();
+  for (size_t i = 0; i < rows.size(); i++) {
+    size += indentation + NEWLINE.size();
+    for (auto const &cell : *rows[i]) {
+      size += cell.get().size() + detail::count_of(cell.get(), "#") + 3; // escaped '#' and " & " or " \\\\"
+      if (!cell.format().background_color().none()) {
+        size += std::string_view("\\cellcolor[HTML]{} ").size() + to_string(cell.format().background_color()).size();
+      }
+    }
+    if (i == 0) {
+      size += std::string_view("\\hline").size() + NEWLINE.size();
+    }
+  }
+  size += std::string_view("\\hline").size() + NEWLINE.size() + std::string_view("\\end{tabular}").size() + NEWLINE.size();
+  return size + std::string_view("\\end{table}").size();
+}
+
+namespace detail
+{
+// writes into a buffer sized up front, what does not fit is dropped
+class BufferSink : public Sink {
+ public:
+  BufferSink(char *data, size_t size) : cursor(data), limit(data + size) {}
+
+  using Sink::write;
+  void write(const char *data, size_t size) override
+  {
+    size = std::min<size_t>(size, limit - cursor);
+    std::memcpy(cursor, data, size);
+    cursor += size;
+  }
+
+ private:
+  char *cursor, *limit;
+};
+} // namespace detail
+
+TABULATE_INLINE bool Table::export_to_file(const std::string &path, Exporter exporter, const RenderProfile &profile, size_t concurrency) const
+{
+  TABULATE_TRACE_SPAN("Table::export_to_file", "rows", rows.size());
+#if defined(__unix__) || defined(__unix) || defined(__APPLE__)
+  if (concurrency == 0) {
+    concurrency = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  concurrency = std::max<size_t>(1, std::min(concurrency, rows.size()));
+
+  // runs function(begin, end) on ranges of the rows
+  auto parallel = [&](const std::function<void(size_t, size_t)> &function) {
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::vector<std::thread> threads;
+    for (size_t id = 0; id < concurrency; id++) {
+      auto work = [&, id]() {
+        try {
+          function(rows.size() * id / concurrency, rows.size() * (id + 1) / concurrency);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex);
+          error = std::current_exception();
+        }
+      };
+      if (id + 1 < concurrency) {
+        threads.emplace_back(work);
+      } else {
+        work();
+      }
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  };
+
+  // the offset of every row in the file, each line is followed by NEWLINE but the last one
+  detail::ProfileFormatters formatters(profile);
+  std::vector<std::vector<TrueColor>> backgrounds;
+  std::vector<std::vector<std::string_view>> contents;
+  std::string glyphs, heading;
+  std::vector<size_t> offsets(rows.size() + 1);
+  // rows below the header take their backgrounds and bars, like in xterm()
+  size_t header_count = 1;
+  auto background_of = [&](size_t i) {
+    return i >= header_count && i < backgrounds.size() && !backgrounds[i].empty() ? backgrounds[i].data() : nullptr;
+  };
+  auto content_of = [&](size_t i) { return i >= header_count && i < contents.size() && !contents[i].empty() ? contents[i].data() : nullptr; };
+  size_t size = exporter == Exporter::xterm ? 0 : rendered_size(exporter, profile);
+  if (exporter == Exporter::xterm) {
+    backgrounds = __backgrounds();
+    contents = __bars(glyphs);
+    if (!title.empty() && rows.size() > 0) {
+      heading = std::string((__width() - title.size()) / 2, ' ') + title;
+      heading += NEWLINE;
+    }
+    parallel([&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        size_t count = 0;
+        offsets[i + 1] = rows[i]->dumped_size(formatters.stringformatter, formatters.borderformatter, formatters.cornerformatter, i, rows.size(),
+                                              background_of(i), content_of(i), count);
+        offsets[i + 1] += count * NEWLINE.size();
+      }
+    });
+    offsets[0] = heading.size();
+    for (size_t i = 0; i < rows.size(); i++) {
+      offsets[i + 1] += offsets[i];
+    }
+    size = offsets[rows.size()] >= NEWLINE.size() ? offsets[rows.size()] - NEWLINE.size() : 0;
+  }
+
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  if (size == 0) {
+    return ::close(fd) == 0;
+  }
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    int failure = errno;
+    ::close(fd);
+    errno = failure;
+    return false;
+  }
+  void *mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int failure = errno;
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    errno = failure;
+    return false;
+  }
+  char *out = static_cast<char *>(mapping);
+
+  if (exporter == Exporter::xterm) {
+    std::memcpy(out, heading.data(), std::min(heading.size(), size));
+    parallel([&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        auto lines = rows[i]->dump(formatters.stringformatter, formatters.borderformatter, formatters.cornerformatter, i, header_count, rows.size(),
+                                   background_of(i), content_of(i));
+        char *cursor = out + offsets[i], *limit = out + std::min(offsets[i + 1], size);
+        for (auto const &line : lines) {
+          size_t bytes = std::min<size_t>(line.size(), limit - cursor);
+          std::memcpy(cursor, line.data(), bytes);
+          cursor += bytes;
+          bytes = std::min<size_t>(NEWLINE.size(), limit - cursor);
+          std::memcpy(cursor, NEWLINE.data(), bytes);
+          cursor += bytes;
+        }
+      }
+    });
+  } else {
+    detail::BufferSink buffer(out, size);
+    exporter == Exporter::markdown ? markdown(buffer) : latex(buffer);
+  }
+
+  TABULATE_STATS_ADD(output_bytes, size);
+  return ::munmap(mapping, size) == 0;
+#else
+  std::string exported = exporter == Exporter::xterm ? xterm(profile) : exporter == Exporter::markdown ? markdown() : latex();
+  (void)concurrency;
+  FILE *file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool written = std::fwrite(exported.data(), 1, exported.size(), file) == exported.size();
+  return std::fclose(file) == 0 && written;
+#endif
+}
+
+// Private helper methods
+TABULATE_INLINE Row &Table::__add_row()
+{
+  auto row = std::make_shared<Row>();
+  rows.push_back(row);
+  return *row;
+}
+
+TABULATE_INLINE void Table::__on_add_auto_update()
+{
+  TABULATE_TRACE_SPAN("Table::__on_add_auto_update", "row", rows.size() - 1);
+  TABULATE_STATS_PHASE(layout_ns);
+  // auto update width
+  size_t headerwidth = 0;
+  for (size_t i = 0; i < column_size(); i++) {
+    Column col = column(i);
+
+    size_t oldwidth = col.size() == 0 ? 0 : col[0].width();
+    size_t newwidth = col[col.size() - 1].width();
+
+    if (newwidth != oldwidth) {
+      if (newwidth > oldwidth) {
+        headerwidth += newwidth;
+        col.format().width(newwidth);
+      } else {
+        headerwidth += oldwidth;
+        col[col.size() - 1].format().width(oldwidth);
+      }
+    } else {
+      headerwidth += oldwidth;
+    }
+  }
+  cached_width = headerwidth;
+
+  // append new cells
+  Row &last_row = *rows[rows.size() - 1];
+  for (size_t i = 0; i < last_row.size(); i++) {
+    cells.push_back(last_row.cell(i));
+  }
+}
+
+TABULATE_INLINE size_t Table::__width() const
+{
+  return __width(*rows[0]);
+}
+
+TABULATE_INLINE size_t Table::__width(const Row &row)
+{
+  size_t size = 0;
+  for (auto const &cell : row) {
+    auto &format = cell.format();
+    if (format.borders.left.visiable) {
+      size += display_width_of(format.borders.left.content, format.locale(), true);
+    }
+    size += format.borders.left.padding + cell.width() + format.borders.right.padding;
+    if (format.borders.right.visiable) {
+      size += display_width_of(format.borders.right.content, format.locale(), true);
+    }
+  }
+  return size;
+}
+
+TABULATE_INLINE std::vector<std::vector<TrueColor>> Table::__backgrounds() const
+{
+  std::vector<std::vector<TrueColor>> backgrounds;
+  if (colormaps.empty() || rows.size() <= 1) {
+    return backgrounds;
+  }
+
+  // one batch per column, the header row is not mapped
+  backgrounds.resize(rows.size());
+  std::vector<double> values(rows.size() - 1);
+  std::vector<TrueColor> colors(rows.size() - 1);
+  for (auto const &entry : colormaps) {
+    size_t index = entry.first;
+    for (size_t i = 1; i < rows.size(); i++) {
+      values[i - 1] = index < rows[i]->size() ? detail::value_of((*rows[i])[index].get()) : std::numeric_limits<double>::quiet_NaN();
+    }
+    entry.second.map(values.data(), values.size(), colors.data());
+    for (size_t i = 1; i < rows.size(); i++) {
+      if (!colors[i - 1].none()) {
+        backgrounds[i].resize(rows[i]->size());
+        backgrounds[i][index] = colors[i - 1];
+      }
+    }
+  }
+
+  return backgrounds;
+}
+
+TABULATE_INLINE std::vector<std::pair<size_t, Table::BarRange>> Table::__bar_ranges() const
+{
+  auto ranges = bars;
+  for (auto &entry : ranges) {
+    if (!entry.second.fitted) {
+      continue;
+    }
+    for (size_t i = 1; i < rows.size(); i++) {
+      double value = entry.first < rows[i]->size() ? detail::value_of((*rows[i])[entry.first].get()) : std::numeric_limits<double>::quiet_NaN();
+      if (!std::isnan(value)) {
+        entry.second.max = std::max(entry.second.max, value);
+      }
+    }
+  }
+
+  return ranges;
+}
+
+TABULATE_INLINE std::vector<std::vector<std::string_view>> Table::__bars(std::string &glyphs) const
+{
+  std::vector<std::vector<std::string_view>> contents;
+  if (bars.empty() || rows.size() <= 1) {
+    return contents;
+  }
+
+  // lengths first, so that all bars are written once into one buffer
+  struct Drawn {
+    size_t row, column, eighths;
   };
-  static const std::vector<std::string> terms_supported_truecolor = {"iterm", "linux", "xterm-truecolor", "xterm-256color"};
+  std::vector<Drawn> drawn;
+  size_t size = 0;
+  for (auto const &entry : __bar_ranges()) {
+    size_t index = entry.first;
+    for (size_t i = 1; i < rows.size(); i++) {
+      double value = index < rows[i]->size() ? detail::value_of((*rows[i])[index].get()) : std::numeric_limits<double>::quiet_NaN();
+      if (!std::isnan(value)) {
+        size_t eighths = detail::bar_eighths(value, entry.second.min, entry.second.max, (*rows[i])[index].width());
+        drawn.push_back({i, index, eighths});
+        size += detail::bar_bytes(eighths);
+      }
+    }
+  }
 
-  return std::find(terms_supported_truecolor.begin(), terms_supported_truecolor.end(), term) != terms_supported_truecolor.end();
+  glyphs.clear();
+  glyphs.reserve(size);
+  contents.resize(rows.size());
+  for (auto const &bar : drawn) {
+    contents[bar.row].resize(rows[bar.row]->size());
+    contents[bar.row][bar.column] = detail::append_bar(glyphs, bar.eighths);
+  }
+
+  return contents;
 }
 
-const bool supported_truecolor = has_truecolor();
+template <>
+TABULATE_INLINE std::string to_string<Table>(const Table &v)
+{
+  // tables nested in cells are rendered when they are added
+  TABULATE_TRACE_SPAN("nested table");
+  return v.xterm();
+}
 
-std::string stringformatter(const std::string &str, TrueColor foreground_color, TrueColor background_color, const Styles &styles)
+namespace detail
 {
-  std::string applied;
+template <typename T>
+std::string stream_to_string(const T &v)
+{
+  std::stringstream ss;
+  ss << v;
 
-  bool have = !foreground_color.none() || !background_color.none() || styles.size() != 0;
+  return ss.str();
+}
+} // namespace detail
 
-  if (have) {
-    auto rgb = [](TrueColor color) -> std::string {
-      auto v = color.RGB();
-      return std::to_string(std::get<0>(v)) + ":" + std::to_string(std::get<1>(v)) + ":" + std::to_string(std::get<2>(v));
-    };
+TABULATE_INLINE std::string __to_string(long long v)
+{
+  return detail::stream_to_string(v);
+}
 
-    auto style_code = [](Style style) -> unsigned int {
-      // @RESERVED
-      unsigned int i = to_underlying(style);
-      switch (i) {
-        case 0 ... 9: // 0 - 9
-          return i;
-        case 10 ... 18: // 21 - 29
-          return i + 11;
-        default:
-          return 0; // none, reset
-      }
-    };
+TABULATE_INLINE std::string __to_string(unsigned long long v)
+{
+  return detail::stream_to_string(v);
+}
 
-    if (!supported_truecolor) {
-      applied += std::string("\033[");
-      applied += std::to_string(to_underlying(TrueColor::most_similar(foreground_color.color)) + 30) + ";";
-      applied += std::to_string(to_underlying(TrueColor::most_similar(background_color.color)) + 40) + ";";
+TABULATE_INLINE std::string __to_string(double v)
+{
+  return detail::stream_to_string(v);
+}
 
-      if (styles.size() > 0) {
-        for (auto const &style : styles) {
-          // style: 0 - 9, 21 - 29
-          applied += std::to_string(style_code(style)) + ";";
-        }
-      }
-      applied[applied.size() - 1] = 'm';
-    } else {
-      if (!foreground_color.none()) {
-        // TrueColor: CSI 38 : 2 : r : g : b m
-        applied += std::string("\033[38:2:") + rgb(foreground_color) + "m";
-      }
+TABULATE_INLINE std::string __to_string(long double v)
+{
+  return detail::stream_to_string(v);
+}
 
-      if (!background_color.none()) {
-        // CSI 48 : 2 : r : g : b m
-        applied += std::string("\033[48:2:") + rgb(background_color) + "m";
-      }
+TABULATE_INLINE std::string __to_string(const void *v)
+{
+  return detail::stream_to_string(v);
+}
 
-      if (styles.size() > 0) {
-        applied += "\033[";
-        for (auto const &style : styles) {
-          // style: 0 - 9, 21 - 29
-          applied += std::to_string(style_code(style)) + ";";
-        }
-        applied[applied.size() - 1] = 'm';
-      }
-    }
-  }
+TABULATE_INLINE std::string __to_string(void (*write)(std::ostream &, const void *), const void *v)
+{
+  std::stringstream ss;
+  write(ss, v);
 
-  applied += str;
+  return ss.str();
+}
+} // namespace tabulate
 
-  if (have) {
-    applied += "\033[00m";
-  }
+namespace tabulate
+{
+// Sink implementation
+TABULATE_INLINE void StringSink::write(const char *data, size_t size)
+{
+  target.append(data, size);
+}
 
-  return applied;
+TABULATE_INLINE FileSink::FileSink(int fd, size_t batch, size_t threshold)
+    : fd(fd), batch(std::max<size_t>(batch, 1)), threshold(std::max<size_t>(threshold, 1)), held(0), failure(0)
+{
+}
+
+TABULATE_INLINE FileSink::~FileSink()
+{
+  flush();
 }
 
-std::string borderformatter(Which which, const Cell *self, const Cell *left, const Cell *right, const Cell *top, const Cell *bottom, size_t expected_size,
-                            StringFormatter stringformatter)
+TABULATE_INLINE void FileSink::write(const char *data, size_t size)
 {
-#define TRY_GET(pattern, which, which_reverse)                                                                                                    \
-  if (self->format().pattern.which.visiable) {                                                                                                    \
-    auto it = self->format().pattern.which;                                                                                                       \
-    return stringformatter(expand_to_size(it.content, expected_size, self->format().multi_bytes_character()), it.color, it.background_color, {}); \
-  } else if (which && which->format().pattern.which_reverse.visiable) {                                                                           \
-    auto it = which->format().pattern.which_reverse;                                                                                              \
-    return stringformatter(expand_to_size(it.content, expected_size, self->format().multi_bytes_character()), it.color, it.background_color, {}); \
+  // consecutive fragments share one piece
+  if (!pieces.empty() && pieces.back().chunk == std::string::npos) {
+    pieces.back().size += size;
+  } else {
+    pieces.push_back(Piece{std::string::npos, fragments.size(), size});
   }
-  if (which == Which::top) {
-    TRY_GET(borders, top, bottom);
-  } else if (which == Which::bottom) {
-    TRY_GET(borders, bottom, top);
-  } else if (which == Which::left) {
-    TRY_GET(borders, left, right);
-  } else if (which == Which::right) {
-    TRY_GET(borders, right, left);
-  } else if (which == Which::cross) {
-    // Cross junction with all four directions
-    TRY_GET(borders, left, right); // Default to using left-right direction
-  } else if (which == Which::bottom_middle) {
-    // T-shape junction pointing north (┴)
-    TRY_GET(borders, top, bottom);
-  } else if (which == Which::top_middle) {
-    // T-shape junction pointing south (┬)
-    TRY_GET(borders, bottom, top);
-  } else if (which == Which::middle_right) {
-    // T-shape junction pointing west (┤)
-    TRY_GET(borders, left, right);
-  } else if (which == Which::middle_left) {
-    // T-shape junction pointing east (├)
-    TRY_GET(borders, right, left);
+  fragments.append(data, size);
+  held += size;
+  if (pieces.size() >= batch || held >= threshold) {
+    flush();
   }
-#undef TRY_GET
-  return "";
 }
 
-std::string cornerformatter(Which which, const Cell *self, const Cell *top_left, const Cell *top_right, const Cell *bottom_left, const Cell *bottom_right,
-                            StringFormatter stringformatter)
+TABULATE_INLINE void FileSink::write_owned(std::string &&data)
 {
-#define TRY_GET(pattern, which, which_reverse)                             \
-  if (self->format().pattern.which.visiable) {                             \
-    auto it = self->format().pattern.which;                                \
-    return stringformatter(it.content, it.color, it.background_color, {}); \
-  } else if (which && which->format().pattern.which_reverse.visiable) {    \
-    auto it = which->format().pattern.which_reverse;                       \
-    return stringformatter(it.content, it.color, it.background_color, {}); \
+  // short strings cost less to copy than an entry of their own
+  if (data.size() < 64) {
+    write(data.data(), data.size());
+    return;
   }
+  chunks.push_back(std::move(data));
+  pieces.push_back(Piece{chunks.size() - 1, 0, chunks.back().size()});
+  held += chunks.back().size();
+  if (pieces.size() >= batch || held >= threshold) {
+    flush();
+  }
+}
 
-  // Junction corners - prioritize specialized corner members
-  if (which == Which::cross) {
-    // Cross junction with all four directions - use dedicated cross member
-    if (self->format().corners.cross.visiable) {
-      auto it = self->format().corners.cross;
-      return stringformatter(it.content, it.color, it.background_color, {});
-    }
-  } else if (which == Which::bottom_middle) {
-    // T-shape junction pointing north (┴) - use dedicated bottom_middle member
-    if (self->format().corners.bottom_middle.visiable) {
-      auto it = self->format().corners.bottom_middle;
-      return stringformatter(it.content, it.color, it.background_color, {});
-    }
-  } else if (which == Which::top_middle) {
-    // T-shape junction pointing south (┬) - use dedicated top_middle member
-    if (self->format().corners.top_middle.visiable) {
-      auto it = self->format().corners.top_middle;
-      return stringformatter(it.content, it.color, it.background_color, {});
+TABULATE_INLINE void FileSink::flush()
+{
+  TABULATE_TRACE_SPAN("FileSink::flush", "pieces", pieces.size());
+#if defined(__unix__) || defined(__unix) || defined(__APPLE__)
+  std::vector<iovec> iov;
+  iov.reserve(pieces.size());
+  for (auto const &piece : pieces) {
+    const char *base = piece.chunk == std::string::npos ? fragments.data() : chunks[piece.chunk].data();
+    iov.push_back(iovec{const_cast<char *>(base + piece.offset), piece.size});
+  }
+
+  size_t first = 0;
+  while (first < iov.size() && failure == 0) {
+    ssize_t written = ::writev(fd, iov.data() + first, static_cast<int>(std::min<size_t>(iov.size() - first, 1024)));
+    if (written < 0) {
+      if (errno != EINTR) {
+        failure = errno;
+      }
+      continue;
     }
-  } else if (which == Which::middle_right) {
-    // T-shape junction pointing west (┤) - use dedicated middle_right member
-    if (self->format().corners.middle_right.visiable) {
-      auto it = self->format().corners.middle_right;
-      return stringformatter(it.content, it.color, it.background_color, {});
+
+    // a short write resumes inside a piece
+    size_t left = static_cast<size_t>(written);
+    while (first < iov.size() && left >= iov[first].iov_len) {
+      left -= iov[first].iov_len;
+      first++;
     }
-  } else if (which == Which::middle_left) {
-    // T-shape junction pointing east (├) - use dedicated middle_left member
-    if (self->format().corners.middle_left.visiable) {
-      auto it = self->format().corners.middle_left;
-      return stringformatter(it.content, it.color, it.background_color, {});
+    if (left > 0) {
+      iov[first].iov_base = static_cast<char *>(iov[first].iov_base) + left;
+      iov[first].iov_len -= left;
     }
   }
-
-  // Basic corners as fallback
-  if (which == Which::top_left || which == Which::cross || which == Which::top_middle || which == Which::middle_left) {
-    TRY_GET(corners, top_left, bottom_right);
-  } else if (which == Which::top_right || which == Which::middle_right) {
-    TRY_GET(corners, top_right, bottom_left);
-  } else if (which == Which::bottom_left || which == Which::bottom_middle) {
-    TRY_GET(corners, bottom_left, top_right);
-  } else if (which == Which::bottom_right) {
-    TRY_GET(corners, bottom_right, top_left);
+#elif defined(_WIN32)
+  for (auto const &piece : pieces) {
+    const char *base = piece.chunk == std::string::npos ? fragments.data() : chunks[piece.chunk].data();
+    for (size_t done = 0; done < piece.size && failure == 0;) {
+      int written = ::_write(fd, base + piece.offset + done, static_cast<unsigned int>(piece.size - done));
+      if (written < 0) {
+        failure = errno;
+      } else {
+        done += static_cast<size_t>(written);
+      }
+    }
   }
+#endif
 
-#undef TRY_GET
+  pieces.clear();
+  chunks.clear();
+  fragments.clear();
+  held = 0;
+}
+
+struct AsyncSink::State {
+  std::mutex mutex;
+  std::condition_variable filled;  // the writer waits for buffers
+  std::condition_variable drained; // the renderer waits for room in the queue
+  std::deque<std::string> queue;
+  std::vector<std::string> spare;
+  std::string current;
+  size_t depth;
+  size_t buffer_size;
+  bool writing = false;
+  bool stopping = false;
+  std::exception_ptr failure;
+  std::thread writer;
+};
 
-  // Default fallback characters when no specific junction is found
-  if (which == Which::cross) {
-    return stringformatter(symbols::cross, Color::none, Color::none, {});
-  } else if (which == Which::bottom_middle) {
-    return stringformatter(symbols::div_down, Color::none, Color::none, {});
-  } else if (which == Which::top_middle) {
-    return stringformatter(symbols::div_up, Color::none, Color::none, {});
-  } else if (which == Which::middle_right) {
-    return stringformatter(symbols::div_right, Color::none, Color::none, {});
-  } else if (which == Which::middle_left) {
-    return stringformatter(symbols::div_left, Color::none, Color::none, {});
-  }
+TABULATE_INLINE AsyncSink::AsyncSink(Sink &target, size_t depth, size_t buffer_size) : target(target), state(new State)
+{
+  state->depth = std::max<size_t>(depth, 1);
+  state->buffer_size = std::max<size_t>(buffer_size, 1);
+  state->current.reserve(state->buffer_size);
+  state->writer = std::thread([this]() {
+    State &s = *state;
+    std::unique_lock<std::mutex> lock(s.mutex);
+    for (;;) {
+      s.filled.wait(lock, [&s]() { return s.stopping || !s.queue.empty(); });
+      if (s.queue.empty()) {
+        break;
+      }
+      std::string buffer = std::move(s.queue.front());
+      s.queue.pop_front();
+      bool failed = s.failure != nullptr;
+      s.writing = true;
+      lock.unlock();
+
+      std::exception_ptr failure;
+      if (!failed) {
+        try {
+          this->target.write_owned(std::move(buffer));
+        } catch (...) {
+          failure = std::current_exception();
+        }
+      }
 
-  return " ";
+      // a buffer the target did not keep is filled again
+      buffer.clear();
+      lock.lock();
+      if (failure && !s.failure) {
+        s.failure = failure;
+      }
+      if (buffer.capacity() >= s.buffer_size && s.spare.size() < s.depth) {
+        s.spare.push_back(std::move(buffer));
+      }
+      s.writing = false;
+      s.drained.notify_all();
+    }
+  });
 }
-} // namespace tabulate::xterm
 
-namespace tabulate
+TABULATE_INLINE AsyncSink::~AsyncSink()
 {
-void Table::set_title(std::string title)
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (!state->current.empty() && !state->failure) {
+      state->drained.wait(lock, [this]() { return state->queue.size() < state->depth || state->failure; });
+      state->queue.push_back(std::move(state->current));
+    }
+    state->stopping = true;
+    state->filled.notify_one();
+  }
+  state->writer.join();
+  if (!state->failure) {
+    try {
+      target.flush();
+    } catch (...) {
+    }
+  }
+}
+
+TABULATE_INLINE void AsyncSink::write(const char *data, size_t size)
 {
-  this->title = std::move(title);
+  std::string &current = state->current;
+  if (!current.empty() && current.size() + size > state->buffer_size) {
+    __handoff(std::move(current));
+  }
+  current.append(data, size);
+  if (current.size() >= state->buffer_size) {
+    __handoff(std::move(current));
+  }
 }
 
-// Table class implementation
-// Basic methods
-BatchFormat Table::format()
+TABULATE_INLINE void AsyncSink::write_owned(std::string &&data)
 {
-  return BatchFormat(cells);
+  // a string as large as a buffer is queued as it is
+  if (data.size() < state->buffer_size) {
+    write(data.data(), data.size());
+    return;
+  }
+  if (!state->current.empty()) {
+    __handoff(std::move(state->current));
+  }
+  __handoff(std::move(data));
 }
 
-Row &Table::add()
+TABULATE_INLINE void AsyncSink::flush()
 {
-  Row &row = __add_row();
-  __on_add_auto_update();
+  if (!state->current.empty()) {
+    __handoff(std::move(state->current));
+  }
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->drained.wait(lock, [this]() { return (state->queue.empty() && !state->writing) || state->failure; });
+    if (state->failure) {
+      std::rethrow_exception(state->failure);
+    }
+  }
+  // the writer is idle until the next handoff
+  target.flush();
+}
 
-  return row;
+TABULATE_INLINE std::exception_ptr AsyncSink::error() const
+{
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->failure;
 }
 
-Row &Table::operator[](size_t index)
+TABULATE_INLINE void AsyncSink::__handoff(std::string &&buffer)
 {
-  if (index >= rows.size()) {
-    size_t size = index + 1 - rows.size();
-    for (size_t i = 0; i < size; i++) {
-      add();
+  TABULATE_TRACE_SPAN("AsyncSink::handoff", "bytes", buffer.size());
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->drained.wait(lock, [this]() { return state->queue.size() < state->depth || state->failure; });
+  if (state->failure) {
+    buffer.clear();
+    std::rethrow_exception(state->failure);
+  }
+  state->queue.push_back(std::move(buffer));
+  state->filled.notify_one();
+
+  // the next buffer to fill is a written one when there is any
+  if (state->current.capacity() < state->buffer_size) {
+    state->current.clear();
+    if (!state->spare.empty()) {
+      state->current = std::move(state->spare.back());
+      state->spare.pop_back();
+    } else {
+      state->current.reserve(state->buffer_size);
     }
   }
-  return *rows[index];
 }
 
-size_t Table::size()
+#if defined(TABULATE_HAS_ZLIB) || defined(TABULATE_HAS_ZSTD)
+namespace detail
 {
-  return rows.size();
-}
+// compressors take input in blocks of this size, smaller writes are gathered first
+constexpr size_t compression_block = 64 * 1024;
+} // namespace detail
+#endif
 
-// Iterator methods
-Table::iterator Table::begin()
+#if defined(TABULATE_HAS_ZLIB)
+struct GzipSink::State {
+  z_stream stream;
+  std::string input;
+  std::vector<char> output;
+  bool open = false;
+  bool finished = false;
+  int failure = 0;
+};
+
+TABULATE_INLINE GzipSink::GzipSink(Sink &target, int level) : target(target), state(new State)
 {
-  return iterator(rows.begin());
+  std::memset(&state->stream, 0, sizeof(state->stream));
+  // 16 added to the window bits selects the gzip header and trailer
+  int rc = deflateInit2(&state->stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+  if (rc != Z_OK) {
+    state->failure = rc;
+    state->finished = true;
+    return;
+  }
+  state->open = true;
+  state->input.reserve(detail::compression_block);
+  state->output.resize(detail::compression_block);
 }
 
-Table::iterator Table::end()
+TABULATE_INLINE GzipSink::~GzipSink()
 {
-  return iterator(rows.end());
+  finish();
+  if (state->open) {
+    deflateEnd(&state->stream);
+  }
 }
 
-Table::const_iterator Table::begin() const
+TABULATE_INLINE void GzipSink::write(const char *data, size_t size)
 {
-  return const_iterator(rows.cbegin());
+  if (state->finished) {
+    return;
+  }
+  if (state->input.size() + size > detail::compression_block) {
+    __compress(state->input.data(), state->input.size(), Z_NO_FLUSH);
+    state->input.clear();
+  }
+  if (size >= detail::compression_block) {
+    __compress(data, size, Z_NO_FLUSH);
+  } else {
+    state->input.append(data, size);
+  }
 }
 
-Table::const_iterator Table::end() const
+TABULATE_INLINE void GzipSink::flush()
 {
-  return const_iterator(rows.cend());
+  if (!state->finished) {
+    __compress(state->input.data(), state->input.size(), Z_SYNC_FLUSH);
+    state->input.clear();
+  }
+  target.flush();
 }
 
-// Column and layout methods
-Column Table::column(size_t index)
+TABULATE_INLINE void GzipSink::finish()
 {
-  Column column;
-  for (auto &row : rows) {
-    if (row->size() <= index) {
-      size_t size = index - row->size() + 1;
-      for (size_t i = 0; i < size; i++) {
-        row->add("");
+  if (state->finished) {
+    return;
+  }
+  __compress(state->input.data(), state->input.size(), Z_FINISH);
+  state->input.clear();
+  state->finished = true;
+  target.flush();
+}
+
+TABULATE_INLINE int GzipSink::error() const
+{
+  return state->failure;
+}
+
+TABULATE_INLINE void GzipSink::__compress(const char *data, size_t size, int mode)
+{
+  z_stream &stream = state->stream;
+  do {
+    // avail_in is 32 bits wide, larger input goes in slices
+    uInt slice = static_cast<uInt>(std::min<size_t>(size, 1u << 30));
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    stream.avail_in = slice;
+    data += slice;
+    size -= slice;
+    int flush = size > 0 ? Z_NO_FLUSH : mode;
+    do {
+      stream.next_out = reinterpret_cast<Bytef *>(state->output.data());
+      stream.avail_out = static_cast<uInt>(state->output.size());
+      int rc = deflate(&stream, flush);
+      if (rc == Z_STREAM_ERROR) {
+        state->failure = rc;
+        state->finished = true;
+        return;
       }
-    }
-    column.add(row->cell(index));
+      size_t produced = state->output.size() - stream.avail_out;
+      if (produced > 0) {
+        target.write(state->output.data(), produced);
+      }
+    } while (stream.avail_out == 0);
+  } while (size > 0);
+}
+#endif
+
+#if defined(TABULATE_HAS_ZSTD)
+struct ZstdSink::State {
+  ZSTD_CCtx *context = nullptr;
+  std::string input;
+  std::vector<char> output;
+  bool finished = false;
+  int failure = 0;
+};
+
+TABULATE_INLINE ZstdSink::ZstdSink(Sink &target, int level) : target(target), state(new State)
+{
+  state->context = ZSTD_createCCtx();
+  if (state->context == nullptr) {
+    state->failure = ZSTD_error_memory_allocation;
+    state->finished = true;
+    return;
   }
+  size_t rc = ZSTD_CCtx_setParameter(state->context, ZSTD_c_compressionLevel, level);
+  if (ZSTD_isError(rc)) {
+    state->failure = ZSTD_getErrorCode(rc);
+    state->finished = true;
+    return;
+  }
+  state->input.reserve(detail::compression_block);
+  state->output.resize(ZSTD_CStreamOutSize());
+}
 
-  return column;
+TABULATE_INLINE ZstdSink::~ZstdSink()
+{
+  finish();
+  ZSTD_freeCCtx(state->context);
+}
+
+TABULATE_INLINE void ZstdSink::write(const char *data, size_t size)
+{
+  if (state->finished) {
+    return;
+  }
+  if (state->input.size() + size > detail::compression_block) {
+    __compress(state->input.data(), state->input.size(), ZSTD_e_continue);
+    state->input.clear();
+  }
+  if (size >= detail::compression_block) {
+    __compress(data, size, ZSTD_e_continue);
+  } else {
+    state->input.append(data, size);
+  }
 }
 
-size_t Table::column_size() const
+TABULATE_INLINE void ZstdSink::flush()
 {
-  size_t max_size = 0;
-  for (auto const &row : rows) {
-    max_size = std::max(max_size, row->size());
+  if (!state->finished) {
+    __compress(state->input.data(), state->input.size(), ZSTD_e_flush);
+    state->input.clear();
   }
-  return max_size;
+  target.flush();
 }
 
-size_t Table::width() const
+TABULATE_INLINE void ZstdSink::finish()
 {
-  return cached_width;
+  if (state->finished) {
+    return;
+  }
+  __compress(state->input.data(), state->input.size(), ZSTD_e_end);
+  state->input.clear();
+  state->finished = true;
+  target.flush();
 }
 
-// Utility methods
-int Table::merge(std::tuple<int, int> from, std::tuple<int, int> to)
+TABULATE_INLINE int ZstdSink::error() const
 {
-  auto fx = std::get<0>(from), tx = std::get<0>(to);
-  auto fy = std::get<1>(from), ty = std::get<1>(to);
-  if (fx != tx && fy != ty) {
-    merges.push_back(std::tuple<int, int, int, int>(fx, fy, tx, ty));
-  }
-
-  return 0;
+  return state->failure;
 }
 
-// Output formatting methods
-std::string Table::xterm(bool disable_color) const
+TABULATE_INLINE void ZstdSink::__compress(const char *data, size_t size, int mode)
 {
-  std::string exported;
-  // add title
-  if (!title.empty() && rows.size() > 0) {
-    exported += std::string((__width() - title.size()) / 2, ' ') + title + NEWLINE;
-  }
-
-  auto stringformatter = [=](const std::string &str, TrueColor foreground_color, TrueColor background_color, const Styles &styles) -> std::string {
-    if (disable_color) {
-      return str;
-    } else {
-      return tabulate::xterm::stringformatter(str, foreground_color, background_color, styles);
+  ZSTD_EndDirective directive = static_cast<ZSTD_EndDirective>(mode);
+  ZSTD_inBuffer in = {data, size, 0};
+  for (;;) {
+    ZSTD_outBuffer out = {state->output.data(), state->output.size(), 0};
+    size_t remaining = ZSTD_compressStream2(state->context, &out, &in, directive);
+    if (ZSTD_isError(remaining)) {
+      state->failure = ZSTD_getErrorCode(remaining);
+      state->finished = true;
+      return;
     }
-  };
-
-  // Determine number of header rows (typically 1)
-  size_t header_count = 1;
-  size_t total_rows = rows.size();
-
-  // add header
-  if (rows.size() > 0) {
-    const auto &header = *rows[0];
-    // Pass row_index=0, header_count, and total_rows instead of boolean flags
-    auto lines = header.dump(stringformatter, tabulate::xterm::borderformatter, tabulate::xterm::cornerformatter, 0, header_count, total_rows);
-    for (auto line : lines) {
-      exported += line + NEWLINE;
+    if (out.pos > 0) {
+      target.write(state->output.data(), out.pos);
     }
-  }
-
-  // add table content
-  for (size_t i = 1; i < rows.size(); i++) {
-    auto const &row = *rows[i];
-    // Pass row_index=i, header_count, and total_rows instead of is_middle flag
-    auto lines = row.dump(stringformatter, tabulate::xterm::borderformatter, tabulate::xterm::cornerformatter, i, header_count, total_rows);
-    for (auto line : lines) {
-      exported += line + NEWLINE;
+    // flush and end are done once nothing is left in the context
+    if (directive == ZSTD_e_continue ? in.pos == in.size : remaining == 0) {
+      return;
     }
   }
-  if (exported.size() >= NEWLINE.size()) {
-    exported.erase(exported.size() - NEWLINE.size(), NEWLINE.size()); // pop last NEWLINE
-  }
+}
+#endif
 
-  return exported;
+TABULATE_INLINE void StreamSink::write(const char *data, size_t size)
+{
+  os.write(data, size);
 }
 
-std::string Table::xterm(size_t maxlines, bool keep_row_in_one_page) const
+TABULATE_INLINE void StreamSink::flush()
 {
-  std::string exported;
-  if (!title.empty() && rows.size() > 0) {
-    size_t size = width();
-    if (size > title.size()) {
-      exported = std::string((size - title.size()) / 2, ' ') + title + NEWLINE;
-    } else {
-      auto lines = wrap_lines(title, size, "", true);
-      for (auto line : lines) {
-        exported += line + NEWLINE;
+  os.flush();
+}
+
+namespace detail
+{
+/**
+ * Job queues of render_batch(): every worker owns a deque seeded with a
+ * contiguous block of job indices, pops from its front and steals from the
+ * back of the other deques once it runs dry.
+ */
+class WorkStealingQueues {
+ public:
+  WorkStealingQueues(size_t workers, size_t jobs) : queues(workers)
+  {
+    for (size_t w = 0; w < workers; w++) {
+      for (size_t i = jobs * w / workers; i < jobs * (w + 1) / workers; i++) {
+        queues[w].jobs.push_back(i);
       }
     }
   }
 
-  // Determine number of header rows (typically 1)
-  size_t header_count = 1;
-  size_t total_rows = rows.size();
-
-  // add header
-  size_t hlines = 0;
-  std::string header;
-  if (rows.size() > 0) {
-    const auto &_header = *rows[0];
-    // Pass row_index=0, header_count, and total_rows
-    auto lines =
-        _header.dump(tabulate::xterm::stringformatter, tabulate::xterm::borderformatter, tabulate::xterm::cornerformatter, 0, header_count, total_rows);
-    for (auto const &line : lines) {
-      hlines++;
-      header += line + NEWLINE;
+  bool next(size_t worker, size_t &job)
+  {
+    for (size_t k = 0; k < queues.size(); k++) {
+      auto &queue = queues[(worker + k) % queues.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.jobs.empty()) {
+        if (k == 0) {
+          job = queue.jobs.front();
+          queue.jobs.pop_front();
+        } else {
+          job = queue.jobs.back();
+          queue.jobs.pop_back();
+        }
+        return true;
+      }
     }
+    return false;
   }
-  if (maxlines <= hlines) { // maxlines too small
-    return header + "===== <Inappropriate Max Lines for PageBreak> ====";
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<size_t> jobs;
+  };
+  std::vector<Queue> queues;
+};
+} // namespace detail
+
+TABULATE_INLINE void render_batch(const std::vector<RenderJob> &jobs, size_t concurrency, const RenderProfile &profile)
+{
+  TABULATE_TRACE_SPAN("render_batch", "jobs", jobs.size());
+  if (concurrency == 0) {
+    concurrency = std::max<size_t>(1, std::thread::hardware_concurrency());
   }
+  concurrency = std::min(concurrency, jobs.size());
 
-  exported += header;
-  size_t nlines = hlines;
-  for (size_t i = 1; i < rows.size(); i++) {
-    auto const &row = *rows[i];
-    // Pass row_index=i, header_count, and total_rows
-    auto lines = row.dump(tabulate::xterm::stringformatter, tabulate::xterm::borderformatter, tabulate::xterm::cornerformatter, i, header_count, total_rows);
+  if (concurrency <= 1) {
+    for (auto const &job : jobs) {
+      job.sink->write(job.table->xterm(profile));
+    }
+    return;
+  }
 
-    if (keep_row_in_one_page) {
-      size_t rowlines = lines.size();
-      if (hlines + rowlines > maxlines) {
-        return exported + "===== <Inappropriate Max Lines for PageBreak> ====";
-      }
-      if (nlines + rowlines > maxlines) {
-        if (exported.size() >= NEWLINE.size()) {
-          exported.erase(exported.size() - NEWLINE.size(), NEWLINE.size()); // pop last NEWLINE
+  // workers collect on their own, the totals go to the statistics of the caller
+  RenderStats *caller_stats = detail::attached_stats();
+
+  detail::WorkStealingQueues queues(concurrency, jobs.size());
+  std::vector<std::string> rendered(jobs.size());
+  std::vector<char> ready(jobs.size(), 0);
+  size_t committed = 0;
+  bool committing = false;
+  std::mutex commit_mutex;
+  std::exception_ptr error;
+  std::atomic<bool> failed(false);
+
+  auto worker = [&](size_t id) {
+    RenderStats stats;
+    std::unique_ptr<RenderStatsScope> scope(caller_stats != nullptr ? new RenderStatsScope(stats) : nullptr);
+
+    size_t index;
+    while (!failed && queues.next(id, index)) {
+      try {
+        std::string output = jobs[index].table->xterm(profile);
+
+        bool committer;
+        {
+          std::lock_guard<std::mutex> lock(commit_mutex);
+          rendered[index] = std::move(output);
+          ready[index] = 1;
+          committer = !committing;
+          committing = true;
         }
-        exported += "\x0c" + header;
-        nlines = hlines;
-      }
-      nlines += rowlines;
-      for (auto const &line : lines) {
-        exported += line + NEWLINE;
-      }
-    } else {
-      for (auto line : lines) {
-        if (nlines >= maxlines) {
-          if (exported.size() >= NEWLINE.size()) {
-            exported.erase(exported.size() - NEWLINE.size(), NEWLINE.size()); // pop last NEWLINE
+
+        // one worker at a time hands finished output to the sinks in job order, outside the lock
+        // so a slow sink does not hold up the others
+        while (committer) {
+          std::vector<std::pair<size_t, std::string>> batch;
+          {
+            std::lock_guard<std::mutex> lock(commit_mutex);
+            while (committed < jobs.size() && ready[committed]) {
+              batch.emplace_back(committed, std::move(rendered[committed]));
+              committed++;
+            }
+            if (batch.empty()) {
+              committing = false;
+              break;
+            }
+          }
+          for (auto const &entry : batch) {
+            jobs[entry.first].sink->write(entry.second);
           }
-          exported += "\x0c" + header;
-          nlines = hlines;
         }
-        nlines++;
-        exported += line;
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(commit_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        failed = true;
       }
     }
+
+    if (caller_stats != nullptr) {
+      scope.reset();
+      std::lock_guard<std::mutex> lock(commit_mutex);
+      *caller_stats += stats;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t id = 1; id < concurrency; id++) {
+    threads.emplace_back(worker, id);
+  }
+  worker(0);
+  for (auto &thread : threads) {
+    thread.join();
   }
 
-  return exported;
+  if (error) {
+    std::rethrow_exception(error);
+  }
 }
 
-std::string Table::markdown() const
+namespace detail
 {
-  std::string exported;
-
-  auto format_cell = [](Cell &cell) {
-    std::string applied;
-
-    auto styles = cell.format().styles();
-    auto foreground_color = cell.format().color();
-    auto background_color = cell.format().background_color();
-    bool have = !foreground_color.none() || !background_color.none() || styles.size() != 0;
-
-    if (have) {
-      applied += "<span style=\"";
-
-      if (!foreground_color.none()) {
-        // color: <color>
-        applied += "color:" + to_string(foreground_color) + ";";
-      }
-
-      if (!background_color.none()) {
-        // color: <color>
-        applied += "background-color:" + to_string(background_color) + ";";
-      }
-
-      for (auto const &style : styles) {
-        switch (style) {
-          case Style::bold:
-            applied += "font-weight:bold;";
-            break;
-          case Style::italic:
-            applied += "font-style:italic;";
-            break;
-          // text-decoration: none|underline|overline|line-through|blink
-          case Style::crossed:
-            applied += "text-decoration:line-through;";
-            break;
-          case Style::underline:
-            applied += "text-decoration:underline;";
-            break;
-          case Style::blink:
-            applied += "text-decoration:blink;";
-            break;
-          default:
-            // unsupported, do nothing
-            break;
-        }
-      }
-      applied += "\">";
+// glyph at a position of a bar cell, aligned in the cell like Row::dump aligns the bar
+TABULATE_INLINE std::string_view bar_glyph(size_t eighths, size_t width, Align align, size_t position)
+{
+  size_t length = (eighths + 7) / 8, offset = 0;
+  if (length < width) {
+    if (align & Align::hcenter) {
+      offset = (width - length) / 2;
+    } else if (align & Align::right) {
+      offset = width - length;
     }
+  }
+  if (position < offset || position >= offset + length) {
+    return " ";
+  }
+  position -= offset;
+  return position < eighths / 8 ? symbols::horizontal_eighths[8] : symbols::horizontal_eighths[eighths % 8];
+}
+} // namespace detail
 
-    applied += [&]() {
-      return replace_all(cell.get(), NEWLINE, "<br>");
-    }();
+TABULATE_INLINE ProgressUpdater::ProgressUpdater(Table &table, Sink &sink, const RenderProfile &profile) : table(table), sink(sink), profile(profile) {}
 
-    if (have) {
-      applied += "</span>";
-    }
+TABULATE_INLINE void ProgressUpdater::render()
+{
+  TABULATE_TRACE_SPAN("ProgressUpdater::render");
+  table.xterm(sink, profile);
+  sink.write(NEWLINE);
+  sink.flush();
 
-    return applied;
-  };
+  // lines and columns as Row::__layout() lays the rows out, counted from the top of the table
+  slots.clear();
+  auto const &rows = table.rows;
+  auto ranges = table.__bar_ranges();
+  auto backgrounds = table.__backgrounds();
+  std::string glyphs;
+  auto contents = table.__bars(glyphs);
+  detail::ProfileFormatters formatters(profile);
+  StringFormatter plain = [](const std::string &str, TrueColor, TrueColor, const Styles &) -> std::string { return str; };
 
+  size_t line = !table.title.empty() && !rows.empty() ? 1 : 0;
   for (size_t i = 0; i < rows.size(); i++) {
-    exported += "| ";
-    for (auto cell : *rows[i]) {
-      exported += format_cell(cell) + " | ";
-    }
-    exported += NEWLINE;
-
-    if (i == 0) {
-      // add alignentment
-      std::string alignment = "|";
-      for (auto const &cell : *rows[0]) {
-        switch (cell.align()) {
-          case Align::left:
-            alignment += " :--";
-            break;
-          case Align::right:
-            alignment += " --:";
-            break;
-          case Align::center:
-            alignment += " :-:";
-            break;
-          default:
-            alignment += " ---";
-            break;
-        }
-        alignment += " |";
+    const Row &row = *rows[i];
+    detail::PositionRecorder recorder(row);
+    row.__layout(recorder, plain, formatters.borderformatter, formatters.cornerformatter, i, rows.size(),
+                 i < backgrounds.size() && !backgrounds[i].empty() ? backgrounds[i].data() : nullptr,
+                 i < contents.size() && !contents[i].empty() ? contents[i].data() : nullptr);
+
+    // the cells drawn as bars by the table
+    for (size_t j = 0; i < contents.size() && j < contents[i].size(); j++) {
+      const Cell &cell = row[j];
+      auto const &place = recorder.places[j];
+      if (contents[i][j].data() == nullptr || cell.width() == 0 || place.text_line > place.last) {
+        continue;
       }
-      exported += alignment + NEWLINE;
+      auto const &range = *detail::find_entry(ranges, j);
+      auto const &first = row[0].format().borders, &last = row[row.size() - 1].format().borders;
+      auto const &borders = cell.format().borders;
+      TrueColor background = i < backgrounds.size() && j < backgrounds[i].size() && !backgrounds[i][j].none() ? backgrounds[i][j] : cell.background_color();
+      size_t eighths = detail::bar_eighths(detail::value_of(cell.get()), range.min, range.max, cell.width());
+      slots.emplace_back(std::make_pair(i, j), Slot{line + place.text_line, place.column + borders.left.padding, cell.width(), eighths, range.min, range.max,
+                                                    cell.format().align(), background, place.text_line - place.first, place.last - place.text_line,
+                                                    first.top.padding, last.bottom.padding, borders.left.padding, borders.right.padding});
     }
-  }
-  if (exported.size() >= NEWLINE.size()) {
-    exported.erase(exported.size() - NEWLINE.size(), NEWLINE.size()); // pop last NEWLINE
+
+    line += recorder.line;
   }
 
-  return exported;
+  // the cursor is on the line below the table
+  for (auto &entry : slots) {
+    entry.second.up = line - entry.second.up;
+  }
 }
 
-std::string Table::latex(size_t indentation) const
+TABULATE_INLINE bool ProgressUpdater::set(size_t row, size_t column, double value)
 {
-  std::string exported = "\\begin{table}[ht]" + NEWLINE;
-  if (!title.empty()) {
-    exported += "\\caption{" + title + "}" + NEWLINE;
-    exported += "\\centering" + NEWLINE; // used for centering table
+  Slot *found = detail::find_entry(slots, std::make_pair(row, column));
+  if (found == nullptr) {
+    return false;
   }
-  exported += "\\begin{tabular}";
+  Slot &slot = *found;
+  Cell &cell = table[row][column];
+  cell.set(value);
+  size_t eighths = detail::bar_eighths(value, slot.min, slot.max, slot.width);
+
+  // the colors of a colormap follow the values, all of them when it is ranged to the column
+  const ColorMap *colormap = detail::find_entry(table.colormaps, column);
+  if (colormap != nullptr) {
+    auto const &rows = table.rows;
+    std::vector<double> values(rows.size() - 1);
+    std::vector<TrueColor> colors(rows.size() - 1);
+    for (size_t i = 1; i < rows.size(); i++) {
+      values[i - 1] = column < rows[i]->size() ? detail::value_of((*rows[i])[column].get()) : std::numeric_limits<double>::quiet_NaN();
+    }
+    colormap->map(values.data(), values.size(), colors.data());
 
-  // add alignment header
-  {
-    exported += "{";
-    for (auto &cell : *rows[0]) {
-      if (cell.align() & Align::left) {
-        exported += 'l';
-      } else if (cell.align() & Align::hcenter) {
-        exported += 'c';
-      } else if (cell.align() & Align::right) {
-        exported += 'r';
+    std::string out;
+    for (auto &entry : slots) {
+      size_t i = entry.first.first;
+      if (entry.first.second != column || i == 0 || i >= rows.size()) {
+        continue;
+      }
+      Slot &other = entry.second;
+      const Cell &target = (*rows[i])[column];
+      TrueColor background = colors[i - 1].none() ? target.background_color() : colors[i - 1];
+      if (background.hex != other.background.hex || (&other == &slot && eighths != slot.eighths)) {
+        other.background = background;
+        if (&other == &slot) {
+          slot.eighths = eighths;
+        }
+        out += __redraw(other, target);
       }
     }
-    exported += "}" + NEWLINE;
+    if (!out.empty()) {
+      sink.write(out);
+      sink.flush();
+    }
+    return true;
   }
-  exported += "\\hline\\hline" + NEWLINE; // %inserts double horizontal lines
 
-  // iterate content and put text into the table.
-  for (size_t i = 0; i < rows.size(); i++) {
-    auto &row = *rows[i];
-    // apply row content indentation
-    if (indentation != 0) {
-      exported += std::string(indentation, ' ');
+  if (eighths == slot.eighths) {
+    return true;
+  }
+  size_t begin = slot.width, end = 0;
+  for (size_t k = 0; k < slot.width; k++) {
+    if (detail::bar_glyph(eighths, slot.width, slot.align, k) != detail::bar_glyph(slot.eighths, slot.width, slot.align, k)) {
+      begin = std::min(begin, k);
+      end = k + 1;
     }
+  }
+  slot.eighths = eighths;
+  if (begin >= end) {
+    return true;
+  }
 
-    for (size_t j = 0; j < row.size(); j++) {
-      auto cell = row[j];
-      auto transfer = [](Cell &cell) {
-        std::string tmp = replace_all(cell.get(), "#", "\\#");
-        if (!(cell.format().background_color().none())) {
-          tmp += "\\cellcolor[HTML]{" + to_string(cell.format().background_color()) + "} ";
+  // up into the table, to the first changed column, then back below the table
+  std::string out = "\x1b[" + std::to_string(slot.up) + "A\x1b[" + std::to_string(slot.column + begin + 1) + "G";
+  std::string run;
+  bool glyphs = false;
+  auto flush = [&]() {
+    if (!run.empty()) {
+      out += glyphs ? xterm::colorize(run, cell.color(), slot.background, cell.styles(), profile.colors())
+                    : xterm::colorize(run, Color::none, slot.background, {}, profile.colors());
+      run.clear();
+    }
+  };
+  for (size_t k = begin; k < end; k++) {
+    auto glyph = detail::bar_glyph(eighths, slot.width, slot.align, k);
+    if ((glyph != " ") != glyphs) {
+      flush();
+      glyphs = glyph != " ";
+    }
+    run += glyph;
+  }
+  flush();
+  out += "\x1b[" + std::to_string(slot.up) + "B\r";
+
+  sink.write(out);
+  sink.flush();
+  return true;
+}
+
+TABULATE_INLINE std::string ProgressUpdater::__redraw(const Slot &slot, const Cell &cell) const
+{
+  // every line of the cell from its left padding to its right padding, then back below the table
+  ColorMode mode = profile.colors();
+  size_t first = slot.up + slot.above, start = slot.column - slot.left;
+  std::string out = "\x1b[" + std::to_string(first) + "A";
+  for (size_t line = first + 1; line-- > slot.up - slot.below;) {
+    out += "\x1b[" + std::to_string(start + 1) + "G";
+    if (line != slot.up) {
+      bool padding = line > slot.up + slot.above - slot.padding_above || line < slot.up - slot.below + slot.padding_below;
+      if (padding) {
+        out += xterm::colorize(std::string(slot.left + slot.width + slot.right, ' '), Color::none, slot.background, {}, mode);
+      } else {
+        out += xterm::colorize(std::string(slot.left, ' '), Color::none, slot.background, {}, mode);
+        out += xterm::colorize(std::string(slot.width, ' '), Color::none, slot.background, cell.styles(), mode);
+        out += xterm::colorize(std::string(slot.right, ' '), Color::none, slot.background, {}, mode);
+      }
+    } else {
+      out += xterm::colorize(std::string(slot.left, ' '), Color::none, slot.background, {}, mode);
+      std::string run;
+      bool glyphs = false;
+      auto flush = [&]() {
+        if (!run.empty()) {
+          out += glyphs ? xterm::colorize(run, cell.color(), slot.background, cell.styles(), mode)
+                        : xterm::colorize(run, Color::none, slot.background, {}, mode);
+          run.clear();
         }
-        return tmp;
       };
-      exported += transfer(cell);
-      exported += (j < row.size() - 1) ? " & " : " \\\\";
+      for (size_t k = 0; k < slot.width; k++) {
+        auto glyph = detail::bar_glyph(slot.eighths, slot.width, slot.align, k);
+        if ((glyph != " ") != glyphs) {
+          flush();
+          glyphs = glyph != " ";
+        }
+        run += glyph;
+      }
+      flush();
+      out += xterm::colorize(std::string(slot.right, ' '), Color::none, slot.background, {}, mode);
     }
-    exported += NEWLINE;
-    if (i == 0) {
-      exported += "\\hline" + NEWLINE;
+    if (line > slot.up - slot.below) {
+      out += "\x1b[1B";
     }
   }
-  exported += "\\hline" + NEWLINE;
-  exported += "\\end{tabular}" + NEWLINE;
-  exported += "\\end{table}";
-
-  return exported;
+  out += "\x1b[" + std::to_string(slot.up - slot.below) + "B\r";
+  return out;
 }
 
-// Private helper methods
-Row &Table::__add_row()
+TABULATE_INLINE Canvas::Canvas(size_t width, size_t height) : columns(width), rows(height), pixels(width * height) {}
+
+TABULATE_INLINE Canvas::Canvas(const std::vector<std::vector<TrueColor>> &matrix) : columns(0), rows(matrix.size())
 {
-  auto row = std::make_shared<Row>();
-  rows.push_back(row);
-  return *row;
+  for (auto const &row : matrix) {
+    columns = std::max(columns, row.size());
+  }
+  pixels.resize(columns * rows);
+  for (size_t y = 0; y < rows; y++) {
+    std::copy(matrix[y].begin(), matrix[y].end(), pixels.begin() + y * columns);
+  }
 }
 
-void Table::__on_add_auto_update()
+TABULATE_INLINE Canvas &Canvas::set(size_t x, size_t y, TrueColor color)
 {
-  // auto update width
-  size_t headerwidth = 0;
-  for (size_t i = 0; i < column_size(); i++) {
-    Column col = column(i);
+  if (x < columns && y < rows) {
+    pixels[y * columns + x] = color;
+  }
 
-    size_t oldwidth = col.size() == 0 ? 0 : col[0].width();
-    size_t newwidth = col[col.size() - 1].width();
+  return *this;
+}
 
-    if (newwidth != oldwidth) {
-      if (newwidth > oldwidth) {
-        headerwidth += newwidth;
-        col.format().width(newwidth);
-      } else {
-        headerwidth += oldwidth;
-        col[col.size() - 1].format().width(oldwidth);
-      }
-    } else {
-      headerwidth += oldwidth;
-    }
-  }
-  cached_width = headerwidth;
+TABULATE_INLINE TrueColor Canvas::get(size_t x, size_t y) const
+{
+  return x < columns && y < rows ? pixels[y * columns + x] : TrueColor();
+}
 
-  // append new cells
-  Row &last_row = *rows[rows.size() - 1];
-  for (size_t i = 0; i < last_row.size(); i++) {
-    cells.push_back(last_row.cell(i));
-  }
+TABULATE_INLINE std::string Canvas::xterm(const RenderProfile &profile) const
+{
+  std::string rendered;
+  StringSink sink(rendered);
+  xterm(sink, profile);
+
+  return rendered;
 }
 
-size_t Table::__width() const
+TABULATE_INLINE void Canvas::xterm(Sink &sink, const RenderProfile &profile) const
 {
-  size_t size = 0;
-  for (auto const &cell : *rows[0]) {
-    auto &format = cell.format();
-    if (format.borders.left.visiable) {
-      size += display_width_of(format.borders.left.content, format.locale(), format.multi_bytes_character());
+  TABULATE_TRACE_SPAN("Canvas::xterm", "pixels", pixels.size());
+  ColorMode mode = profile.colors();
+  std::string line;
+  for (size_t y = 0; y < rows; y += 2) {
+    line.clear();
+    TrueColor foreground, background; // as set by the escape sequences so far
+    for (size_t x = 0; x < columns; x++) {
+      TrueColor top = get(x, y), bottom = get(x, y + 1), fg, bg;
+      std::string_view glyph = " ";
+      if (!profile.unicode) {
+        // no half blocks, both pixels blend into the background
+        bg = top.none() ? bottom : bottom.none() ? top : TrueColor::merge(top, bottom);
+      } else if (top.none()) {
+        glyph = bottom.none() ? " " : symbols::lower_half;
+        fg = bottom;
+      } else if (bottom.none() || bottom.hex == top.hex) {
+        glyph = bottom.none() ? symbols::upper_half : symbols::horizontal_eighths[8];
+        fg = top;
+      } else {
+        glyph = symbols::upper_half;
+        fg = top;
+        bg = bottom;
+      }
+
+      // run-length encoded, sequences only where the colors change
+      if (mode != ColorMode::none && (fg.hex != foreground.hex || bg.hex != background.hex)) {
+        if ((fg.none() && !foreground.none()) || (bg.none() && !background.none())) {
+          line += "\033[00m";
+          foreground = background = TrueColor();
+        }
+        if (mode == ColorMode::basic) {
+          // basic sequences always set both colors
+          if (!fg.none() || !bg.none()) {
+            TABULATE_STATS_ADD(sgrs, 1);
+            line += xterm::detail::sgr_of(fg, bg, {}, mode);
+          }
+        } else {
+          if (fg.hex != foreground.hex) {
+            TABULATE_STATS_ADD(sgrs, 1);
+            line += xterm::detail::sgr_of(fg, TrueColor(), {}, mode);
+          }
+          if (bg.hex != background.hex) {
+            TABULATE_STATS_ADD(sgrs, 1);
+            line += xterm::detail::sgr_of(TrueColor(), bg, {}, mode);
+          }
+        }
+        foreground = fg;
+        background = bg;
+      }
+      line += glyph;
     }
-    size += format.borders.left.padding + cell.width() + format.borders.right.padding;
-    if (format.borders.right.visiable) {
-      size += display_width_of(format.borders.right.content, format.locale(), format.multi_bytes_character());
+    if (!foreground.none() || !background.none()) {
+      line += "\033[00m";
+    }
+
+    if (y > 0) {
+      sink.write(NEWLINE);
     }
+    sink.write(line);
   }
-  return size;
 }
 } // namespace tabulate
 
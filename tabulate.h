@@ -27,22 +27,22 @@
  * limitations under the License.
  */
 
+#pragma once
+
 #include <string>
 #include <vector>
-#include <cctype>
-#include <cassert>
-#include <sstream>
-#include <functional>
-#include <clocale>
-#include <wchar.h>
-#include <math.h>
-#include <iostream>
-#include <locale>
-#include <algorithm>
-#include <regex>
-#include <map>
-#include <iomanip>
 #include <array>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <functional>
+#include <exception>
+#include <string_view>
+#include <type_traits>
+#include <iosfwd>
+#include <cstddef>
+#include <cstdint>
+#include "tabulate_fwd.h"
 
 #if defined(__GNUC__)
 #  pragma GCC diagnostic ignored "-Wswitch-enum"
@@ -50,6 +50,20 @@
 #  pragma clang diagnostic ignored "-Wswitch-enum"
 #endif
 
+/**
+ * @def TABULATE_HEADER_ONLY
+ * @brief Define before including tabulate.h to use tabulate without the compiled library
+ *
+ * The implementation is then included by this header and every definition is
+ * inline, so the compiler can inline the hot paths into the caller. Do not link
+ * the tabulate library into a program that defines it.
+ */
+#if defined(TABULATE_HEADER_ONLY)
+#  define TABULATE_INLINE inline
+#else
+#  define TABULATE_INLINE
+#endif
+
 /**
  * @namespace tabulate
  * @brief A modern C++ tabular data representation library
@@ -86,6 +100,17 @@ enum Align { none = 0, left = 1, hcenter = 2, right = 4, center = 18, top = 8, v
  */
 enum class Color { black, red, green, yellow, blue, magenta, cyan, white, RESERVED, none };
 
+/**
+ * @enum ColorMode
+ * @brief Color depth of the escape sequences in xterm output
+ */
+enum class ColorMode {
+  none,      // no escape sequences at all
+  basic,     // the eight basic colors, SGR 30-37/40-47
+  xterm256,  // the 256 color palette, SGR 38;5;n/48;5;n
+  truecolor, // 24-bit colors, SGR 38:2:r:g:b/48:2:r:g:b
+};
+
 /**
  * @enum Which
  * @brief Specifies different positions within a table
@@ -183,6 +208,15 @@ struct TrueColor {
    */
   static TrueColor merge(const TrueColor &a, const TrueColor &b);
 
+  /**
+   * @brief Merges two colors by interpolating their RGB values
+   * @param a First color
+   * @param b Second color
+   * @param ratio Position between the colors, 0 gives @p a and 1 gives @p b
+   * @return The interpolated color
+   */
+  static TrueColor merge(const TrueColor &a, const TrueColor &b, double ratio);
+
   /**
    * @brief Calculates the similarity between two colors
    * @param a First color
@@ -193,11 +227,26 @@ struct TrueColor {
 
   /**
    * @brief Finds the basic color most similar to a true color
+   *
+   * Searches the eight basic colors without allocating, cheap enough to
+   * call for every fragment when downgrading to a basic color terminal.
+   *
    * @param a The color to match
-   * @return The most similar basic Color from the Color enum
+   * @return The most similar basic Color from the Color enum, Color::none for the default color
    */
   static Color most_similar(const TrueColor &a);
 
+  /**
+   * @brief Finds the entry of the xterm 256 color palette closest to a true color
+   *
+   * Maps to the 6x6x6 color cube or the 24 step grayscale ramp with integer
+   * arithmetic only.
+   *
+   * @param a The color to match
+   * @return Palette index in [16, 255]
+   */
+  static int most_similar_256(const TrueColor &a);
+
  public:
   int hex;
   Color color;
@@ -206,6 +255,88 @@ struct TrueColor {
   static const int DEFAULT = 0xFF000000;
 };
 
+/**
+ * @class ColorMap
+ * @brief Maps numeric values to colors along a gradient
+ *
+ * The gradient runs through evenly spaced color stops, values are placed on
+ * it by a linear or logarithmic scale. Used to color whole columns of a
+ * table as a heatmap, see Table::colormap().
+ */
+class ColorMap {
+ public:
+  /**
+   * @enum Scale
+   * @brief How values are placed on the gradient
+   */
+  enum class Scale { linear, log };
+
+  /**
+   * @brief Constructor that takes the color stops of the gradient
+   * @param stops At least one color, from the lowest to the highest value
+   * @param scale The scale values are placed on the gradient by
+   */
+  ColorMap(std::vector<TrueColor> stops, Scale scale = Scale::linear);
+
+  /**
+   * @brief Sets the values mapped to the first and the last stop
+   *
+   * Values outside the range are clamped. Without a range the minimum and
+   * maximum of the mapped values are used.
+   *
+   * @param min The value mapped to the first stop
+   * @param max The value mapped to the last stop
+   * @return Reference to this color map for method chaining
+   */
+  ColorMap &range(double min, double max);
+
+  /**
+   * @brief Checks if a range has been set
+   * @return true if range() has been called, false otherwise
+   */
+  bool ranged() const
+  {
+    return has_range;
+  }
+
+  /**
+   * @brief Gets a copy of the color map ranged to a set of values
+   *
+   * Keeps the range if one has been set. NaN is ignored, and so are values
+   * that are not positive on a log scale.
+   *
+   * @param values The values to range to
+   * @param count Number of values
+   * @return The ranged color map
+   */
+  ColorMap fit(const double *values, size_t count) const;
+
+  /**
+   * @brief Maps a batch of values to colors
+   *
+   * NaN maps to the default color. The values are mapped in blocks with
+   * scratch arrays on the stack, two positions at a time with SSE2.
+   *
+   * @param values The values to map
+   * @param count Number of values
+   * @param colors Receives @p count colors
+   */
+  void map(const double *values, size_t count, TrueColor *colors) const;
+
+  /**
+   * @brief Maps a single value to a color
+   * @param value The value to map
+   * @return The color of the value
+   */
+  TrueColor operator()(double value) const;
+
+ private:
+  std::vector<TrueColor> stops;
+  Scale scale;
+  bool has_range;
+  double min, max;
+};
+
 // Forward declaration of the Cell class
 class Cell;
 
@@ -235,8 +366,43 @@ using CornerFormatter = std::function<std::string(Which which, const Cell *self,
 
 namespace tabulate
 {
+/**
+ * @brief Formats a value the way std::ostream does, defined in tabulate.cc so
+ *        that this header needs no stream header
+ * @param v The value to format
+ * @return String representation of the value
+ */
+extern std::string __to_string(long long v);
+extern std::string __to_string(unsigned long long v);
+extern std::string __to_string(double v);
+extern std::string __to_string(long double v);
+extern std::string __to_string(const void *v);
+
+/**
+ * @brief Streams a value into a string with a type-erased writer
+ * @param write Writes the value to the stream
+ * @param v The value to write
+ * @return What @p write put into the stream
+ */
+extern std::string __to_string(void (*write)(std::ostream &, const void *), const void *v);
+
+/**
+ * @brief Writes a value with its operator<<, the writer of __to_string
+ * @tparam T The type of the value
+ */
+template <typename T>
+void __write_to(std::ostream &os, const void *v)
+{
+  os << *static_cast<const T *>(v);
+}
+
 /**
  * @brief Converts any type to a string representation
+ *
+ * Arithmetic values, pointers and strings are formatted as std::ostream would.
+ * Other types are written with their operator<<, which needs the definition of
+ * std::ostream where it is instantiated.
+ *
  * @tparam T The type to convert
  * @param v The value to convert
  * @return String representation of the value
@@ -244,10 +410,25 @@ namespace tabulate
 template <typename T>
 inline std::string to_string(const T &v)
 {
-  std::stringstream ss;
-  ss << v;
-
-  return ss.str();
+  if constexpr (std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value) {
+    return std::string(1, static_cast<char>(v));
+  } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+    return __to_string(static_cast<long long>(v));
+  } else if constexpr (std::is_integral<T>::value) {
+    return __to_string(static_cast<unsigned long long>(v));
+  } else if constexpr (std::is_same<T, long double>::value) {
+    return __to_string(v);
+  } else if constexpr (std::is_floating_point<T>::value) {
+    return __to_string(static_cast<double>(v));
+  } else if constexpr (std::is_null_pointer<T>::value) {
+    return "nullptr";
+  } else if constexpr (std::is_constructible<std::string, const T &>::value) {
+    return std::string(v);
+  } else if constexpr (std::is_convertible<const T &, const void *>::value) {
+    return __to_string(static_cast<const void *>(v));
+  } else {
+    return __to_string(&__write_to<T>, &v);
+  }
 }
 
 /**
@@ -320,13 +501,7 @@ inline std::string to_string<Color>(const Color &v)
  * @return Hexadecimal string representation (e.g., "#FF0000")
  */
 template <>
-inline std::string to_string<TrueColor>(const TrueColor &v)
-{
-  std::stringstream ss;
-  ss << "#" << std::setfill('0') << std::setw(6) << std::hex << v.hex;
-
-  return std::string(ss.str());
-}
+TABULATE_INLINE std::string to_string<TrueColor>(const TrueColor &v);
 
 /**
  * @brief Specialized conversion for Style enum values
@@ -366,7 +541,7 @@ namespace tabulate
 /**
  * @brief Newline character sequence for text formatting
  */
-static const std::string NEWLINE = "\n";
+inline constexpr std::string_view NEWLINE = "\n";
 
 /**
  * @brief Calculates the display width of a string considering locale
@@ -431,90 +606,173 @@ extern std::string expand_to_size(const std::string &s, size_t len, bool multi_b
 namespace tabulate::symbols
 {
 /** Horizontal line symbol */
-const std::string hline = "─";
-const std::string hline_light = "─";
-const std::string hline_heavy = "━";
-const std::string hline_double = "═";
+inline constexpr std::string_view hline = "─";
+inline constexpr std::string_view hline_light = "─";
+inline constexpr std::string_view hline_heavy = "━";
+inline constexpr std::string_view hline_double = "═";
 
 /** Vertical line symbol */
-const std::string vline = "│";
-const std::string vline_light = "│";
-const std::string vline_heavy = "┃";
-const std::string vline_double = "║";
+inline constexpr std::string_view vline = "│";
+inline constexpr std::string_view vline_light = "│";
+inline constexpr std::string_view vline_heavy = "┃";
+inline constexpr std::string_view vline_double = "║";
 
 /** Dotted vertical line symbol */
-const std::string dotted_vline = "╎"; // U+254E
+inline constexpr std::string_view dotted_vline = "╎"; // U+254E
 
 /** Dotted horizontal line symbol */
-const std::string dotted_hline = "╍"; // U+254D
+inline constexpr std::string_view dotted_hline = "╍"; // U+254D
 
 /** Dashed vertical line symbol */
-const std::string dashed_vline = "┆"; // U+2506
+inline constexpr std::string_view dashed_vline = "┆"; // U+2506
 
 /** Dashed horizontal line symbol */
-const std::string dashed_hline = "┄"; // U+2504
+inline constexpr std::string_view dashed_hline = "┄"; // U+2504
 
 /** Left-up corner symbol */
-const std::string left_up = "┌";
+inline constexpr std::string_view left_up = "┌";
 /** Right-up corner symbol */
-const std::string right_up = "┐";
+inline constexpr std::string_view right_up = "┐";
 /** Left-down corner symbol */
-const std::string left_down = "└";
+inline constexpr std::string_view left_down = "└";
 /** Right-down corner symbol */
-const std::string right_down = "┘";
+inline constexpr std::string_view right_down = "┘";
 
 /** Rounded left-up corner symbol */
-const std::string round_left_up = "╭";
+inline constexpr std::string_view round_left_up = "╭";
 /** Rounded right-up corner symbol */
-const std::string round_right_up = "╮";
+inline constexpr std::string_view round_right_up = "╮";
 /** Rounded left-down corner symbol */
-const std::string round_left_down = "╰";
+inline constexpr std::string_view round_left_down = "╰";
 /** Rounded right-down corner symbol */
-const std::string round_right_down = "╯";
+inline constexpr std::string_view round_right_down = "╯";
 
 /** Title left-down symbol */
-const std::string title_left_down = "┘";
+inline constexpr std::string_view title_left_down = "┘";
 /** Title right-down symbol */
-const std::string title_right_down = "└";
+inline constexpr std::string_view title_right_down = "└";
 /** Title left symbol */
-const std::string title_left = "┐";
+inline constexpr std::string_view title_left = "┐";
 /** Title right symbol */
-const std::string title_right = "┌";
+inline constexpr std::string_view title_right = "┌";
 
 /** Cross symbol */
-const std::string cross = "┼";
+inline constexpr std::string_view cross = "┼";
 
 /** Right division symbol */
-const std::string div_right = "┤";
+inline constexpr std::string_view div_right = "┤";
 /** Left division symbol */
-const std::string div_left = "├";
+inline constexpr std::string_view div_left = "├";
 /** Up division symbol */
-const std::string div_up = "┬";
+inline constexpr std::string_view div_up = "┬";
 /** Down division symbol */
-const std::string div_down = "┴";
+inline constexpr std::string_view div_down = "┴";
 
 /** Up arrow symbol */
-const std::string arrow_up = "↑";
+inline constexpr std::string_view arrow_up = "↑";
 /** Down arrow symbol */
-const std::string arrow_down = "↓";
+inline constexpr std::string_view arrow_down = "↓";
 /** Left arrow symbol */
-const std::string arrow_left = "←";
+inline constexpr std::string_view arrow_left = "←";
 /** Right arrow symbol */
-const std::string arrow_right = "→";
+inline constexpr std::string_view arrow_right = "→";
 
 /** Keyboard enter symbol */
-const std::string keyboard_enter = "↵";
+inline constexpr std::string_view keyboard_enter = "↵";
 
 /** Meter/block symbol */
-const std::string meter = "■";
+inline constexpr std::string_view meter = "■";
+
+/** Left blocks from 0/8 to 8/8 of a character, for horizontal bars */
+inline constexpr std::array<std::string_view, 9> horizontal_eighths = {"", "▏", "▎", "▍", "▌", "▋", "▊", "▉", "█"};
+
+/** Upper and lower half blocks, for two pixels per character */
+inline constexpr std::string_view upper_half = "▀";
+inline constexpr std::string_view lower_half = "▄";
 
 /** Array of superscript digit symbols */
-const std::array<std::string, 10> superscript = {"⁰", "¹", "²", "³", "⁴", "⁵", "⁶", "⁷", "⁸", "⁹"};
+inline constexpr std::array<std::string_view, 10> superscript = {"⁰", "¹", "²", "³", "⁴", "⁵", "⁶", "⁷", "⁸", "⁹"};
+
+/**
+ * @enum GraphStyle
+ * @brief Glyph sets for graphs that draw two series per character
+ */
+enum class GraphStyle { braille_up, braille_down, block_up, block_down, tty_up, tty_down };
+
+/**
+ * @brief Glyphs of every graph style, indexed by 5 * left level + right level, with levels 0 to 4
+ */
+// clang-format off
+inline constexpr std::array<std::array<std::string_view, 25>, 6> graph_table = {{
+  // braille_up
+  {{
+    " ", "⢀", "⢠", "⢰", "⢸",
+    "⡀", "⣀", "⣠", "⣰", "⣸",
+    "⡄", "⣄", "⣤", "⣴", "⣼",
+    "⡆", "⣆", "⣦", "⣶", "⣾",
+    "⡇", "⣇", "⣧", "⣷", "⣿"
+  }},
+  // braille_down
+  {{
+    " ", "⠈", "⠘", "⠸", "⢸",
+    "⠁", "⠉", "⠙", "⠹", "⢹",
+    "⠃", "⠋", "⠛", "⠻", "⢻",
+    "⠇", "⠏", "⠟", "⠿", "⢿",
+    "⡇", "⡏", "⡟", "⡿", "⣿"
+  }},
+  // block_up
+  {{
+    " ", "▗", "▗", "▐", "▐",
+    "▖", "▄", "▄", "▟", "▟",
+    "▖", "▄", "▄", "▟", "▟",
+    "▌", "▙", "▙", "█", "█",
+    "▌", "▙", "▙", "█", "█"
+  }},
+  // block_down
+  {{
+    " ", "▝", "▝", "▐", "▐",
+    "▘", "▀", "▀", "▜", "▜",
+    "▘", "▀", "▀", "▜", "▜",
+    "▌", "▛", "▛", "█", "█",
+    "▌", "▛", "▛", "█", "█"
+  }},
+  // tty_up
+  {{
+    " ", "░", "░", "▒", "▒",
+    "░", "░", "▒", "▒", "█",
+    "░", "▒", "▒", "▒", "█",
+    "▒", "▒", "▒", "█", "█",
+    "▒", "█", "█", "█", "█"
+  }},
+  // tty_down
+  {{
+    " ", "░", "░", "▒", "▒",
+    "░", "░", "▒", "▒", "█",
+    "░", "▒", "▒", "▒", "█",
+    "▒", "▒", "▒", "█", "█",
+    "▒", "█", "█", "█", "█"
+  }}
+}};
+// clang-format on
+
+/**
+ * @brief Gets the glyphs of a graph style
+ * @param style The graph style
+ * @return The 25 glyphs of the style, indexed by 5 * left level + right level
+ */
+constexpr const std::array<std::string_view, 25> &graph_symbols(GraphStyle style)
+{
+  return graph_table[to_underlying(style)];
+}
 
 /**
  * @brief Gets a collection of graph symbols by name
- * @param name The name of the symbol set to retrieve
- * @return Vector of symbol strings
+ *
+ * The vectors are built on first use, graph_symbols() indexes the glyphs
+ * without allocating.
+ *
+ * @param name The name of the symbol set to retrieve, as the GraphStyle enumerator
+ * @return Vector of symbol strings, empty for an unknown name
  */
 const std::vector<std::string> &get_graph_symbols(const std::string &name);
 
@@ -545,6 +803,86 @@ const std::vector<std::string> &get_graph_symbols(const std::string &name);
 // ›
 } // namespace tabulate::symbols
 
+namespace tabulate
+{
+/**
+ * @class Sparkline
+ * @brief Series of values drawn inside one cell, two values per character
+ *
+ * Each value becomes a bar of up to 4 levels per line, drawn with the 5x5
+ * graph glyphs of a GraphStyle, so one cell holds a whole time series. The
+ * values are not copied: they must outlive the sparkline, which is rendered
+ * when it is added to a row.
+ */
+class Sparkline {
+ public:
+  /**
+   * @brief Constructor that takes the values to draw
+   * @param values The values, NaN draws an empty bar
+   * @param count Number of values
+   * @param style The glyphs, the _up styles draw bars upwards and the _down styles downwards
+   * @param height Number of lines, each adds 4 levels
+   */
+  Sparkline(const double *values, size_t count, symbols::GraphStyle style = symbols::GraphStyle::braille_up, size_t height = 1)
+      : values(values), count(count), style(style), height(height == 0 ? 1 : height), has_range(false), min(0), max(0)
+  {
+  }
+
+  /**
+   * @brief Constructor that takes the values to draw
+   * @param values The values, NaN draws an empty bar
+   * @param style The glyphs, the _up styles draw bars upwards and the _down styles downwards
+   * @param height Number of lines, each adds 4 levels
+   */
+  Sparkline(const std::vector<double> &values, symbols::GraphStyle style = symbols::GraphStyle::braille_up, size_t height = 1)
+      : Sparkline(values.data(), values.size(), style, height)
+  {
+  }
+
+  /**
+   * @brief Sets the values drawn as an empty and as a full bar
+   *
+   * Without a range, the sparkline spans the minimum and maximum of its values.
+   *
+   * @param min The value drawn as an empty bar
+   * @param max The value drawn as a full bar
+   * @return Reference to this Sparkline for method chaining
+   */
+  Sparkline &range(double min, double max);
+
+  /**
+   * @brief Gets the display width of the sparkline
+   * @return Number of characters per line
+   */
+  size_t width() const
+  {
+    return (count + 1) / 2;
+  }
+
+  /**
+   * @brief Renders the sparkline
+   * @return The lines of glyphs, separated by NEWLINE
+   */
+  std::string str() const;
+
+ private:
+  const double *values;
+  size_t count;
+  symbols::GraphStyle style;
+  size_t height;
+  bool has_range;
+  double min, max;
+};
+
+/**
+ * @brief Specialized conversion of Sparkline to string
+ * @param v The Sparkline to convert
+ * @return The rendered sparkline
+ */
+template <>
+TABULATE_INLINE std::string to_string<Sparkline>(const Sparkline &v);
+} // namespace tabulate
+
 namespace tabulate
 {
 class Cell;
@@ -2235,13 +2573,36 @@ class Row {
    * @param row_index The index of this row in the table (0-based)
    * @param header_count Number of header rows in the table
    * @param total_rows Total number of rows in the table
+   * @param backgrounds Background colors overriding those of the cells, one per cell, the default color keeps the cell's own, or nullptr
+   * @param contents Single-line contents drawn instead of those of the cells, one per cell, a null view keeps the cell's own, or nullptr
    * @return Vector of formatted strings representing the row
    */
   std::vector<std::string> dump(StringFormatter stringformatter, BorderFormatter borderformatter, CornerFormatter cornerformatter, size_t row_index,
-                                size_t header_count, size_t total_rows) const;
+                                size_t header_count, size_t total_rows, const TrueColor *backgrounds = nullptr,
+                                const std::string_view *contents = nullptr) const;
+
+  /**
+   * @brief Computes the size of the output of dump() without producing it
+   *
+   * Takes the arguments of dump() but the header count, and walks the same
+   * layout. Contents are measured, only the border and corner glyphs are
+   * formatted.
+   *
+   * @param line_count Receives the number of lines
+   * @return Total bytes of the lines, without separators
+   */
+  size_t dumped_size(StringFormatter stringformatter, BorderFormatter borderformatter, CornerFormatter cornerformatter, size_t row_index,
+                     size_t total_rows, const TrueColor *backgrounds, const std::string_view *contents, size_t &line_count) const;
 
  private:
   std::vector<std::shared_ptr<Cell>> cells;
+
+  // lays the row out line by line into the output of dump(), dumped_size() or ProgressUpdater::render()
+  template <typename Output>
+  void __layout(Output &output, const StringFormatter &stringformatter, const BorderFormatter &borderformatter, const CornerFormatter &cornerformatter,
+                size_t row_index, size_t total_rows, const TrueColor *backgrounds, const std::string_view *contents) const;
+
+  friend class ProgressUpdater;
 };
 
 /**
@@ -2358,6 +2719,23 @@ namespace xterm
  */
 bool has_truecolor();
 
+/**
+ * @brief Gets the color mode used when none is requested explicitly
+ * @return ColorMode::truecolor if the terminal supports it, ColorMode::basic otherwise
+ */
+ColorMode color_mode();
+
+/**
+ * @brief Formats a string with color and style for xterm at a given color depth
+ * @param str The string to format
+ * @param foreground_color The text color
+ * @param background_color The background color
+ * @param styles The text styles to apply
+ * @param mode The color depth of the escape sequences
+ * @return The formatted string with ANSI escape sequences
+ */
+std::string colorize(const std::string &str, TrueColor foreground_color, TrueColor background_color, const Styles &styles, ColorMode mode);
+
 /**
  * @brief Formats a string with color and style for xterm
  * @param str The string to format
@@ -2402,131 +2780,635 @@ std::string cornerformatter(Which which, const Cell *self, const Cell *top_left,
 namespace tabulate
 {
 /**
- * @class Table
- * @brief Main class for creating and managing tables
+ * @struct RenderProfile
+ * @brief Capabilities of the terminal or file a table is rendered for
  *
- * Provides comprehensive functionality for building, formatting,
- * and rendering tables in various output formats.
+ * Passed to a render call so one process can render for a truecolor
+ * terminal and a plain log file at the same time. Escape sequences and
+ * box drawing glyphs that are not wanted are never generated.
+ *
+ * Without unicode, the border and corner formatters pick ASCII for the box
+ * drawing glyphs of the formats, one character per glyph, before borders are
+ * expanded to the widths of the cells. Box drawing glyphs are one column wide
+ * in UTF-8 locales, so the layout is the same. Cell contents are not
+ * transliterated.
  */
-class Table : public std::enable_shared_from_this<Table> {
- public:
+struct RenderProfile {
   /**
-   * @brief Default constructor that creates an empty table
+   * @brief Default constructor, the profile tabulate renders with when none is given
+   *
+   * Colors follow xterm::color_mode(), glyphs are unicode.
    */
-  Table() = default;
+  RenderProfile();
 
   /**
-   * @brief Constructor that creates a table with a single row of values
-   * @tparam Args Variadic template for row values
-   * @param args The values to add to the first row
+   * @brief Detects the profile of an output file descriptor
+   *
+   * Looks at isatty(), $NO_COLOR, $TERM, $COLORTERM and the locale variables.
+   *
+   * @param fd The file descriptor the table will be written to
+   * @return The detected profile
    */
-  template <typename... Args>
-  Table(Args... args)
+  static RenderProfile detect(int fd = 1);
+
+  /**
+   * @brief Gets the color depth escape sequences are generated with
+   * @return ColorMode::none unless the output is a terminal that wants colors
+   */
+  ColorMode colors() const
   {
-    add(args...);
+    return no_color || !isatty ? ColorMode::none : color;
   }
 
+  ColorMode color; // color depth supported by the terminal
+  bool unicode;    // box drawing glyphs, ASCII '-', '|' and '+' otherwise
+  bool no_color;   // colors disabled by the user (NO_COLOR)
+  bool isatty;     // output goes to a terminal
+};
+
+/**
+ * @struct RenderStats
+ * @brief Counters and phase timings collected while rendering
+ *
+ * Collected only when tabulate is built with TABULATE_RENDER_STATS defined,
+ * otherwise the counting compiles to nothing and the counters stay zero.
+ * Attach an instance to the renders of a thread with RenderStatsScope.
+ */
+struct RenderStats {
+  size_t rows = 0;            // rows rendered
+  size_t cells = 0;           // cells rendered
+  size_t width_calls = 0;     // calls to display_width_of()
+  size_t width_bytes = 0;     // bytes measured by display_width_of()
+  size_t wraps = 0;           // calls to wrap_lines()
+  size_t sgrs = 0;            // SGR escape sequences emitted
+  size_t output_bytes = 0;    // bytes of output produced by the exporters
+  size_t allocations = 0;     // allocations reported by count_allocation()
+  size_t allocated_bytes = 0; // bytes reported by count_allocation()
+  uint64_t layout_ns = 0;     // time spent fitting column widths to added or sampled rows, and on colormaps and bars
+  uint64_t dump_ns = 0;       // time spent in Row::dump(), wrapping the cells included
+  uint64_t join_ns = 0;       // time spent joining lines into the output
+
   /**
-   * @brief Sets the title of the table
-   * @param title The title string
+   * @brief Checks if tabulate was built to collect statistics
+   * @return true if built with TABULATE_RENDER_STATS, false otherwise
    */
-  void set_title(std::string title);
+  static bool enabled();
 
   /**
-   * @brief Creates a batch formatter for all cells in the table
-   * @return BatchFormat object for the entire table
+   * @brief Reports an allocation to the statistics attached to this thread
+   *
+   * tabulate does not replace operator new, an application or benchmark that
+   * does can forward its allocations here.
+   *
+   * @param bytes Size of the allocation
    */
-  BatchFormat format();
+  static void count_allocation(size_t bytes);
 
   /**
-   * @brief Adds an empty row to the table
-   * @return Reference to the new row
+   * @brief Adds the counters and timings of another instance
+   * @param other The statistics to add
+   * @return Reference to this instance
    */
-  Row &add();
+  RenderStats &operator+=(const RenderStats &other);
+};
 
+/**
+ * @class RenderStatsScope
+ * @brief Attaches RenderStats to every render of the current thread while in scope
+ *
+ * Scopes nest, the innermost one collects. render_batch() adds the work of
+ * its worker threads to the statistics attached to the calling thread.
+ */
+class RenderStatsScope {
+ public:
   /**
-   * @brief Adds a row with a single value
-   * @tparam T The type of the value
-   * @param arg The value to add
-   * @return Reference to the new row
+   * @brief Constructor that attaches the statistics
+   * @param stats The statistics to collect into
    */
-  template <typename T>
-  Row &add(T arg)
-  {
-    Row &row = __add_row();
-    row.add(arg);
-    __on_add_auto_update();
-
-    return row;
-  }
+  explicit RenderStatsScope(RenderStats &stats);
 
   /**
-   * @brief Adds a row with multiple values
-   * @tparam Args Variadic template for row values
-   * @param args The values to add to the row
-   * @return Reference to the new row
+   * @brief Destructor that restores the previously attached statistics
    */
-  template <typename... Args>
-  Row &add(Args... args)
-  {
-    Row &row = __add_row();
-    row.add(args...);
-    __on_add_auto_update();
+  ~RenderStatsScope();
 
-    return row;
-  }
+  RenderStatsScope(const RenderStatsScope &) = delete;
+  RenderStatsScope &operator=(const RenderStatsScope &) = delete;
 
-  /**
-   * @brief Adds a row with values from a container
-   * @tparam Value The type of values in the container
-   * @tparam Container The container type
-   * @tparam Allocator The allocator type for the container
-   * @param multiple The container of values to add
-   * @return Reference to the new row
-   */
-  template <typename Value, template <typename, typename> class Container, typename Allocator = std::allocator<Value>>
-  Row &add_multiple(const Container<Value, Allocator> &multiple)
-  {
-    Row &row = __add_row();
-    for (auto const &value : multiple) {
-      row.add(value);
-    }
-    __on_add_auto_update();
+ private:
+  RenderStats *previous;
+};
 
-    return row;
-  }
+// https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+namespace trace
+{
+/**
+ * @brief Starts recording spans of the layout and render phases
+ *
+ * Tables added, measured and rendered from now on record begin/end spans,
+ * which stop() writes as Chrome trace-event JSON, ready for chrome://tracing
+ * or the Perfetto UI. Only available when tabulate is built with
+ * TABULATE_TRACE defined, otherwise the hooks compile to nothing.
+ *
+ * @param path The file the trace is written to
+ * @return true if recording started, false if tracing is not built in or the file cannot be created
+ */
+bool start(const std::string &path);
 
-  /**
-   * @brief Array access operator to get a row by index
-   * @param index The index of the row to retrieve
-   * @return Reference to the row at the specified index
-   */
-  Row &operator[](size_t index);
+/**
+ * @brief Stops recording and writes the recorded spans
+ */
+void stop();
+} // namespace trace
+
+/**
+ * @class Sink
+ * @brief Destination for rendered output
+ *
+ * Exporters and the batch renderer hand their output to a sink, so it can
+ * be appended to a string, streamed to an ostream or forwarded elsewhere.
+ */
+class Sink {
+ public:
+  virtual ~Sink() = default;
 
   /**
-   * @brief Gets the number of rows in the table
-   * @return The row count
+   * @brief Writes a chunk of rendered output
+   * @param data Pointer to the bytes to write
+   * @param size Number of bytes to write
    */
-  size_t size();
+  virtual void write(const char *data, size_t size) = 0;
 
-  /* iterator */
   /**
-   * @typedef iterator
-   * @brief Iterator type for Table rows
+   * @brief Writes a string of rendered output
+   * @param data The string to write
    */
-  using iterator = PtrIterator<std::vector, Row>;
+  void write(std::string_view data)
+  {
+    write(data.data(), data.size());
+  }
 
   /**
-   * @typedef const_iterator
-   * @brief Const iterator type for Table rows
+   * @brief Writes a string of rendered output the sink may keep
+   *
+   * The renderer hands over the lines it no longer needs, so sinks that
+   * gather output can reference them instead of copying.
+   *
+   * @param data The string to write
    */
-  using const_iterator = PtrConstIterator<std::vector, Row>;
+  virtual void write_owned(std::string &&data)
+  {
+    write(data.data(), data.size());
+  }
 
   /**
-   * @brief Gets an iterator to the beginning of the table
-   * @return Iterator pointing to the first row
+   * @brief Flushes any buffered output to the destination
    */
-  iterator begin();
+  virtual void flush() {}
+};
+
+/**
+ * @class StringSink
+ * @brief Sink that appends output to a string
+ */
+class StringSink : public Sink {
+ public:
+  /**
+   * @brief Constructor that takes the string to append to
+   * @param target The string receiving the output
+   */
+  explicit StringSink(std::string &target) : target(target) {}
+
+  using Sink::write;
+  void write(const char *data, size_t size) override;
+
+ private:
+  std::string &target;
+};
+
+/**
+ * @class StreamSink
+ * @brief Sink that writes output to an output stream
+ */
+class StreamSink : public Sink {
+ public:
+  /**
+   * @brief Constructor that takes the stream to write to
+   * @param os The stream receiving the output
+   */
+  explicit StreamSink(std::ostream &os) : os(os) {}
+
+  using Sink::write;
+  void write(const char *data, size_t size) override;
+  void flush() override;
+
+ private:
+  std::ostream &os;
+};
+
+/**
+ * @class FileSink
+ * @brief Sink that gathers output and writes it to a file descriptor with writev()
+ *
+ * Lines handed over with write_owned() are kept and referenced, other output
+ * is copied into a fragment buffer. The pieces go out with one writev() call
+ * once @p batch pieces or @p threshold bytes are held, so a large table is
+ * written as it renders, without joining its lines into one string first.
+ * The file descriptor is not closed.
+ */
+class FileSink : public Sink {
+ public:
+  /**
+   * @brief Constructor that takes the file descriptor to write to
+   * @param fd The file descriptor receiving the output
+   * @param batch Number of pieces gathered before they are written
+   * @param threshold Number of bytes gathered before they are written
+   */
+  explicit FileSink(int fd, size_t batch = 1024, size_t threshold = 64 * 1024);
+  ~FileSink() override;
+
+  using Sink::write;
+  void write(const char *data, size_t size) override;
+  void write_owned(std::string &&data) override;
+  void flush() override;
+
+  /**
+   * @brief Gets the error of the first failed write
+   * @return The errno of the failure, 0 if all output was written
+   */
+  int error() const
+  {
+    return failure;
+  }
+
+ private:
+  struct Piece {
+    size_t chunk, offset, size; // chunk is npos for the fragment buffer
+  };
+
+  int fd;
+  size_t batch;
+  size_t threshold;
+  size_t held; // bytes of the pieces
+  int failure;
+  std::vector<std::string> chunks;
+  std::string fragments;
+  std::vector<Piece> pieces;
+};
+
+/**
+ * @class AsyncSink
+ * @brief Sink that hands output to a writer thread through a bounded queue of buffers
+ *
+ * Output fills a buffer while the writer thread passes the previous ones to
+ * the target with write_owned(), so rendering and I/O overlap. Once @p depth
+ * full buffers are queued, writes block until the writer catches up. An
+ * exception thrown by the target is rethrown by the next write(), flush()
+ * or buffer handoff, and later output is dropped.
+ */
+class AsyncSink : public Sink {
+ public:
+  /**
+   * @brief Constructor that starts the writer thread
+   * @param target The sink receiving the output, only used by the writer thread until flush()
+   * @param depth Number of full buffers that may wait for the writer
+   * @param buffer_size Size of each buffer in bytes
+   */
+  explicit AsyncSink(Sink &target, size_t depth = 4, size_t buffer_size = 64 * 1024);
+
+  /**
+   * @brief Writes the remaining output and stops the writer thread, errors are not rethrown
+   */
+  ~AsyncSink() override;
+
+  using Sink::write;
+  void write(const char *data, size_t size) override;
+  void write_owned(std::string &&data) override;
+
+  /**
+   * @brief Waits until all queued output is written, then flushes the target
+   */
+  void flush() override;
+
+  /**
+   * @brief Gets the exception thrown by the target
+   * @return The first exception of the writer thread, null if it succeeded
+   */
+  std::exception_ptr error() const;
+
+ private:
+  struct State;
+  Sink &target;
+  std::unique_ptr<State> state;
+
+  void __handoff(std::string &&buffer);
+};
+
+#if defined(TABULATE_HAS_ZLIB)
+/**
+ * @class GzipSink
+ * @brief Sink that compresses output in gzip format into another sink
+ *
+ * Output is buffered in 64 KiB blocks and deflated as it arrives, so
+ * rendering and compression are pipelined and memory stays at the deflate
+ * window and the buffers. Available when tabulate is built with zlib.
+ */
+class GzipSink : public Sink {
+ public:
+  /**
+   * @brief Constructor that takes the sink receiving the compressed output
+   * @param target The sink receiving the gzip stream
+   * @param level Compression level from 1 (fastest) to 9 (smallest)
+   */
+  explicit GzipSink(Sink &target, int level = 6);
+  ~GzipSink() override;
+
+  using Sink::write;
+  void write(const char *data, size_t size) override;
+
+  /**
+   * @brief Compresses the buffered output so far and flushes the target
+   */
+  void flush() override;
+
+  /**
+   * @brief Ends the gzip stream, called by the destructor, later output is ignored
+   */
+  void finish();
+
+  /**
+   * @brief Gets the error of the first failure
+   * @return The zlib error code, 0 if compression succeeded
+   */
+  int error() const;
+
+ private:
+  struct State;
+  Sink &target;
+  std::unique_ptr<State> state;
+
+  void __compress(const char *data, size_t size, int mode);
+};
+#endif
+
+#if defined(TABULATE_HAS_ZSTD)
+/**
+ * @class ZstdSink
+ * @brief Sink that compresses output in zstd format into another sink
+ *
+ * Streams like GzipSink, with the zstd frame format. Available when
+ * tabulate is built with libzstd.
+ */
+class ZstdSink : public Sink {
+ public:
+  /**
+   * @brief Constructor that takes the sink receiving the compressed output
+   * @param target The sink receiving the zstd frame
+   * @param level Compression level, 1 (fastest) to 19 (smallest)
+   */
+  explicit ZstdSink(Sink &target, int level = 3);
+  ~ZstdSink() override;
+
+  using Sink::write;
+  void write(const char *data, size_t size) override;
+
+  /**
+   * @brief Compresses the buffered output so far and flushes the target
+   */
+  void flush() override;
+
+  /**
+   * @brief Ends the zstd frame, called by the destructor, later output is ignored
+   */
+  void finish();
+
+  /**
+   * @brief Gets the error of the first failure
+   * @return The zstd error code, 0 if compression succeeded
+   */
+  int error() const;
+
+ private:
+  struct State;
+  Sink &target;
+  std::unique_ptr<State> state;
+
+  void __compress(const char *data, size_t size, int mode);
+};
+#endif
+
+/**
+ * @class RowSource
+ * @brief Supplies table rows on demand
+ *
+ * Lets the renderer pull rows one at a time (from a database cursor, a
+ * generator, ...) instead of materialising them in a Table first.
+ */
+class RowSource {
+ public:
+  virtual ~RowSource() = default;
+
+  /**
+   * @brief Fills in the next row
+   * @param row An empty row to add the cells to
+   * @return false once the source is exhausted
+   */
+  virtual bool next(Row &row) = 0;
+};
+
+/**
+ * @class FunctionRowSource
+ * @brief Row source backed by a callable
+ */
+class FunctionRowSource : public RowSource {
+ public:
+  /**
+   * @brief Constructor that takes the callable producing rows
+   * @param generator Fills in a row and returns true, or returns false when done
+   */
+  explicit FunctionRowSource(std::function<bool(Row &)> generator) : generator(std::move(generator)) {}
+
+  bool next(Row &row) override
+  {
+    return generator(row);
+  }
+
+ private:
+  std::function<bool(Row &)> generator;
+};
+
+/**
+ * @class RangeRowSource
+ * @brief Row source backed by an input range whose elements are rows of values
+ *
+ * Works with any single-pass range, including coroutine generators, every
+ * element is a container of values added as cells.
+ *
+ * @tparam Iterator The iterator type of the range
+ * @tparam Sentinel The sentinel type of the range
+ */
+template <typename Iterator, typename Sentinel = Iterator>
+class RangeRowSource : public RowSource {
+ public:
+  /**
+   * @brief Constructor that takes the range to pull rows from
+   * @param begin Iterator to the first row
+   * @param end Sentinel past the last row
+   */
+  RangeRowSource(Iterator begin, Sentinel end) : it(std::move(begin)), end(std::move(end)) {}
+
+  bool next(Row &row) override
+  {
+    if (it == end) {
+      return false;
+    }
+    for (auto const &value : *it) {
+      row.add(value);
+    }
+    ++it;
+    return true;
+  }
+
+ private:
+  Iterator it;
+  Sentinel end;
+};
+} // namespace tabulate
+
+namespace tabulate
+{
+/**
+ * @enum Exporter
+ * @brief Output formats of a table
+ */
+enum class Exporter { xterm, markdown, latex };
+
+/**
+ * @class Table
+ * @brief Main class for creating and managing tables
+ *
+ * Provides comprehensive functionality for building, formatting,
+ * and rendering tables in various output formats.
+ */
+class Table : public std::enable_shared_from_this<Table> {
+ public:
+  /**
+   * @brief Default constructor that creates an empty table
+   */
+  Table() = default;
+
+  /**
+   * @brief Constructor that creates a table with a single row of values
+   * @tparam Args Variadic template for row values
+   * @param args The values to add to the first row
+   */
+  template <typename... Args>
+  Table(Args... args)
+  {
+    add(args...);
+  }
+
+  /**
+   * @brief Sets the title of the table
+   * @param title The title string
+   */
+  void set_title(std::string title);
+
+  /**
+   * @brief Creates a batch formatter for all cells in the table
+   * @return BatchFormat object for the entire table
+   */
+  BatchFormat format();
+
+  /**
+   * @brief Adds an empty row to the table
+   * @return Reference to the new row
+   */
+  Row &add();
+
+  /**
+   * @brief Adds a row with a single value
+   * @tparam T The type of the value
+   * @param arg The value to add
+   * @return Reference to the new row
+   */
+  template <typename T>
+  Row &add(T arg)
+  {
+    Row &row = __add_row();
+    row.add(arg);
+    __on_add_auto_update();
+
+    return row;
+  }
+
+  /**
+   * @brief Adds a row with multiple values
+   * @tparam Args Variadic template for row values
+   * @param args The values to add to the row
+   * @return Reference to the new row
+   */
+  template <typename... Args>
+  Row &add(Args... args)
+  {
+    Row &row = __add_row();
+    row.add(args...);
+    __on_add_auto_update();
+
+    return row;
+  }
+
+  /**
+   * @brief Adds a row with values from a container
+   * @tparam Value The type of values in the container
+   * @tparam Container The container type
+   * @tparam Allocator The allocator type for the container
+   * @param multiple The container of values to add
+   * @return Reference to the new row
+   */
+  template <typename Value, template <typename, typename> class Container, typename Allocator = std::allocator<Value>>
+  Row &add_multiple(const Container<Value, Allocator> &multiple)
+  {
+    Row &row = __add_row();
+    for (auto const &value : multiple) {
+      row.add(value);
+    }
+    __on_add_auto_update();
+
+    return row;
+  }
+
+  /**
+   * @brief Array access operator to get a row by index
+   * @param index The index of the row to retrieve
+   * @return Reference to the row at the specified index
+   */
+  Row &operator[](size_t index);
+
+  /**
+   * @brief Gets the number of rows in the table
+   * @return The row count
+   */
+  size_t size();
+
+  /* iterator */
+  /**
+   * @typedef iterator
+   * @brief Iterator type for Table rows
+   */
+  using iterator = PtrIterator<std::vector, Row>;
+
+  /**
+   * @typedef const_iterator
+   * @brief Const iterator type for Table rows
+   */
+  using const_iterator = PtrConstIterator<std::vector, Row>;
+
+  /**
+   * @brief Gets an iterator to the beginning of the table
+   * @return Iterator pointing to the first row
+   */
+  iterator begin();
 
   /**
    * @brief Gets an iterator to the end of the table
@@ -2553,6 +3435,52 @@ class Table : public std::enable_shared_from_this<Table> {
    */
   Column column(size_t index);
 
+  /**
+   * @brief Colors the background of a column by the values of its cells
+   *
+   * The colors are computed for the whole column when rendering, the cells
+   * keep their formats. Rows below the header whose cell does not start with
+   * a number keep their own background.
+   *
+   * @param index The index of the column
+   * @param colormap The gradient mapping values to colors
+   * @return Reference to this table for method chaining
+   */
+  Table &colormap(size_t index, ColorMap colormap);
+
+  /**
+   * @brief Draws a column as horizontal bars of its values
+   *
+   * Rows below the header whose cell starts with a number are drawn as a bar
+   * of block elements, with 1/8 character precision, where @p max fills the
+   * width of the cell. The bars of the whole column are computed in one pass
+   * when rendering, other cells keep their content.
+   *
+   * @param index The index of the column
+   * @param min The value drawn as an empty bar
+   * @param max The value drawn as a full bar
+   * @return Reference to this table for method chaining
+   */
+  Table &bar(size_t index, double min, double max);
+
+  /**
+   * @brief Draws a column as horizontal bars, from 0 to its largest value
+   * @param index The index of the column
+   * @return Reference to this table for method chaining
+   */
+  Table &bar(size_t index);
+
+  /**
+   * @brief Draws a column as progress bars of percentages
+   *
+   * Same as bar(index, 0, 100), the cells of the column are usually changed
+   * in place with a ProgressUpdater.
+   *
+   * @param index The index of the column
+   * @return Reference to this table for method chaining
+   */
+  Table &progress(size_t index);
+
   /**
    * @brief Gets the number of columns in the table
    * @return The column count
@@ -2580,6 +3508,57 @@ class Table : public std::enable_shared_from_this<Table> {
    */
   std::string xterm(bool disable_color = false) const;
 
+  /**
+   * @brief Renders the table in xterm format into a sink
+   * @param sink The sink receiving the output
+   * @param disable_color Whether to disable color in the output
+   */
+  void xterm(Sink &sink, bool disable_color = false) const;
+
+  /**
+   * @brief Renders the table in xterm format at a given color depth
+   * @param mode The color depth of the escape sequences
+   * @return String representation of the table
+   */
+  std::string xterm(ColorMode mode) const;
+
+  /**
+   * @brief Renders the table in xterm format at a given color depth into a sink
+   * @param sink The sink receiving the output
+   * @param mode The color depth of the escape sequences
+   */
+  void xterm(Sink &sink, ColorMode mode) const;
+
+  /**
+   * @brief Renders the table in xterm format for an output profile
+   * @param profile Capabilities of the output
+   * @return String representation of the table
+   */
+  std::string xterm(const RenderProfile &profile) const;
+
+  /**
+   * @brief Renders the table in xterm format for an output profile into a sink
+   * @param sink The sink receiving the output
+   * @param profile Capabilities of the output
+   */
+  void xterm(Sink &sink, const RenderProfile &profile) const;
+
+  /**
+   * @brief Renders rows pulled from a source in xterm format
+   *
+   * The table supplies the title, the header rows and the column layout, the
+   * body rows are pulled from @p source and written to @p sink one at a time,
+   * so memory use does not grow with the number of rows. All rows of the
+   * table are header rows, colormaps and bars apply to the body rows only.
+   *
+   * @param source The source of the body rows
+   * @param sink The sink receiving the output
+   * @param sample Number of rows buffered to estimate the column widths, 0 to use the header widths as declared; a table
+   *               without rows has no widths to declare, and takes them from at least the first body row
+   * @param profile Capabilities of the output
+   */
+  void xterm(RowSource &source, Sink &sink, size_t sample = 0, const RenderProfile &profile = RenderProfile()) const;
+
   /**
    * @brief Renders the table in xterm format with page breaks
    * @param maxlines Maximum number of lines per page
@@ -2594,6 +3573,12 @@ class Table : public std::enable_shared_from_this<Table> {
    */
   std::string markdown() const;
 
+  /**
+   * @brief Renders the table in Markdown format into a sink, a row at a time
+   * @param sink Receives the rendered output
+   */
+  void markdown(Sink &sink) const;
+
   /**
    * @brief Renders the table in LaTeX format
    * @param indentation Number of spaces to indent content lines
@@ -2601,11 +3586,55 @@ class Table : public std::enable_shared_from_this<Table> {
    */
   std::string latex(size_t indentation = 0) const;
 
+  /**
+   * @brief Renders the table in LaTeX format into a sink, a row at a time
+   * @param sink Receives the rendered output
+   * @param indentation Number of spaces to indent content lines
+   */
+  void latex(Sink &sink, size_t indentation = 0) const;
+
+  /**
+   * @brief Computes the exact size of an export without producing it
+   *
+   * Sums content bytes, padding, glyphs and escape sequences from the layout,
+   * so files, mappings or buffers can be sized before rendering.
+   *
+   * @param exporter The output format
+   * @param profile Capabilities of the output, for xterm
+   * @param indentation Number of spaces to indent content lines, for latex
+   * @return Number of bytes of xterm(profile), markdown() or latex(indentation)
+   */
+  size_t rendered_size(Exporter exporter = Exporter::xterm, const RenderProfile &profile = RenderProfile(), size_t indentation = 0) const;
+
+  /**
+   * @brief Exports the table to a file through a memory mapping
+   *
+   * The file is sized with rendered_size() and mapped, then the rows are
+   * rendered straight into the mapping, by ranges of rows on @p concurrency
+   * threads. There is no intermediate buffer and no write call per chunk.
+   * Markdown and LaTeX are streamed into the mapping on one thread.
+   *
+   * @param path The file to create or truncate
+   * @param exporter The output format
+   * @param profile Capabilities of the output, for xterm
+   * @param concurrency Number of threads rendering xterm rows, 0 for hardware concurrency
+   * @return false if the file could not be written, errno tells why
+   */
+  bool export_to_file(const std::string &path, Exporter exporter = Exporter::xterm, const RenderProfile &profile = RenderProfile(),
+                      size_t concurrency = 1) const;
+
  private:
   std::string title;
   std::vector<std::shared_ptr<Row>> rows;
   std::vector<std::shared_ptr<Cell>> cells; // for batch format
   std::vector<std::tuple<int, int, int, int>> merges;
+  std::vector<std::pair<size_t, ColorMap>> colormaps; // sorted by column
+
+  struct BarRange {
+    double min, max;
+    bool fitted;
+  };
+  std::vector<std::pair<size_t, BarRange>> bars; // sorted by column
 
   size_t cached_width;
 
@@ -2625,6 +3654,36 @@ class Table : public std::enable_shared_from_this<Table> {
    * @return The calculated width
    */
   size_t __width() const;
+
+  /**
+   * @brief Helper method to calculate the display width of a row
+   * @param row The row to measure
+   * @return The calculated width
+   */
+  static size_t __width(const Row &row);
+
+  /**
+   * @brief Helper method to compute the backgrounds of the color mapped columns
+   * @return Background overrides for every row, empty if no column is color mapped
+   */
+  std::vector<std::vector<TrueColor>> __backgrounds() const;
+
+  /**
+   * @brief Helper method to draw the bar columns
+   * @param glyphs Receives the glyphs of all bars
+   * @return Views into @p glyphs for every row, empty if no column is drawn as bars
+   */
+  std::vector<std::vector<std::string_view>> __bars(std::string &glyphs) const;
+
+  /**
+   * @brief Helper method to compute the ranges of the bar columns
+   * @return The range of every bar column, fitted ranges extended to the largest value
+   */
+  std::vector<std::pair<size_t, BarRange>> __bar_ranges() const;
+
+  friend class ProgressUpdater;
+  template <typename... Cols>
+  friend class TypedTable;
 };
 
 /**
@@ -2638,7 +3697,8 @@ inline std::string to_string<Row>(const Row &v)
   std::string ret;
   auto lines = v.dump(tabulate::xterm::stringformatter, tabulate::xterm::borderformatter, tabulate::xterm::cornerformatter, 0, 0, 1);
   for (auto &line : lines) {
-    ret += line + NEWLINE;
+    ret += line;
+    ret += NEWLINE;
   }
   return ret;
 }
@@ -2649,8 +3709,364 @@ inline std::string to_string<Row>(const Row &v)
  * @return String representation of the table in xterm format
  */
 template <>
-inline std::string to_string<Table>(const Table &v)
+TABULATE_INLINE std::string to_string<Table>(const Table &v);
+
+/**
+ * @struct RenderJob
+ * @brief A table and the sink its rendered output goes to
+ */
+struct RenderJob {
+  const Table *table;
+  Sink *sink;
+};
+
+/**
+ * @brief Renders many tables in xterm format on a work-stealing thread pool
+ *
+ * Layout and rendering run in parallel, output is handed to the sinks in the
+ * order of @p jobs, so several jobs may share one sink. Sinks are never
+ * written concurrently. Workers keep their width, glyph and SGR caches across
+ * all tables they render.
+ *
+ * @param jobs The tables to render and their sinks
+ * @param concurrency Number of worker threads, 0 for hardware concurrency
+ * @param profile Capabilities of the output
+ */
+void render_batch(const std::vector<RenderJob> &jobs, size_t concurrency = 0, const RenderProfile &profile = RenderProfile());
+
+/**
+ * @class ProgressUpdater
+ * @brief Updates the bar cells of a rendered table in place on a terminal
+ *
+ * render() prints the table followed by a newline and remembers where the
+ * bar of every cell of the bar columns is on the screen. set() then changes
+ * the value of one cell and writes only the cursor moves and the glyphs that
+ * differ from the last frame, so a tick costs output in the number of changed
+ * characters, not in the size of the table. Bars keep the ranges and the
+ * layout of the last render(), nothing else may be printed in between.
+ * In a column with a colormap(), the cells whose color changes with the new
+ * value are redrawn whole, padding included. A colormap without range() is
+ * fitted to the column, so one new value can change every color, and a tick
+ * then writes the whole column.
+ */
+class ProgressUpdater {
+ public:
+  /**
+   * @brief Constructs an updater for a table
+   * @param table The table, must outlive the updater
+   * @param sink The terminal the table is rendered to
+   * @param profile Capabilities of the terminal
+   */
+  ProgressUpdater(Table &table, Sink &sink, const RenderProfile &profile = RenderProfile());
+
+  /**
+   * @brief Renders the whole table and records the positions of the bars
+   */
+  void render();
+
+  /**
+   * @brief Changes the value of a bar cell and redraws what changed
+   * @param row The index of the row
+   * @param column The index of the column
+   * @param value The new value of the cell
+   * @return false if the cell was not drawn as a bar by the last render(), nothing is written then
+   */
+  bool set(size_t row, size_t column, double value);
+
+ private:
+  struct Slot {
+    size_t up, column, width, eighths;
+    double min, max;
+    Align align;
+    TrueColor background;
+    size_t above, below, padding_above, padding_below, left, right; // lines of the cell around the bar, padding lines among them
+  };
+
+  Table &table;
+  Sink &sink;
+  RenderProfile profile;
+  std::vector<std::pair<std::pair<size_t, size_t>, Slot>> slots; // sorted by row and column
+
+  std::string __redraw(const Slot &slot, const Cell &cell) const;
+};
+
+/**
+ * @class Canvas
+ * @brief Bitmap drawn with half blocks, two pixel rows per line
+ *
+ * Every character shows the pixel above with its foreground and the pixel
+ * below with its background, without borders, padding or width computation.
+ * Escape sequences are written only where the colors change along a line.
+ * Pixels of the default color are transparent.
+ */
+class Canvas {
+ public:
+  /**
+   * @brief Constructs a transparent canvas
+   * @param width Number of pixels per row
+   * @param height Number of pixel rows
+   */
+  Canvas(size_t width, size_t height);
+
+  /**
+   * @brief Constructs a canvas from a matrix of pixels
+   * @param matrix The rows of pixels, shorter rows are padded with transparent pixels
+   */
+  Canvas(const std::vector<std::vector<TrueColor>> &matrix);
+
+  /**
+   * @brief Sets the color of a pixel, pixels outside the canvas are ignored
+   * @param x The column of the pixel
+   * @param y The row of the pixel
+   * @param color The color, the default color is transparent
+   * @return Reference to this Canvas for method chaining
+   */
+  Canvas &set(size_t x, size_t y, TrueColor color);
+
+  /**
+   * @brief Gets the color of a pixel
+   * @param x The column of the pixel
+   * @param y The row of the pixel
+   * @return The color, the default color outside the canvas
+   */
+  TrueColor get(size_t x, size_t y) const;
+
+  /**
+   * @brief Gets the number of pixels per row
+   * @return The width, also the number of characters per line
+   */
+  size_t width() const
+  {
+    return columns;
+  }
+
+  /**
+   * @brief Gets the number of pixel rows
+   * @return The height, twice the number of lines rounded up
+   */
+  size_t height() const
+  {
+    return rows;
+  }
+
+  /**
+   * @brief Renders the canvas in xterm format
+   * @param profile Capabilities of the output
+   * @return The lines, separated by NEWLINE
+   */
+  std::string xterm(const RenderProfile &profile = RenderProfile()) const;
+
+  /**
+   * @brief Renders the canvas in xterm format into a sink
+   * @param sink Receives the lines, separated by NEWLINE
+   * @param profile Capabilities of the output
+   */
+  void xterm(Sink &sink, const RenderProfile &profile = RenderProfile()) const;
+
+ private:
+  size_t columns, rows;
+  std::vector<TrueColor> pixels;
+};
+} // namespace tabulate
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+namespace tabulate
 {
-  return v.xterm();
-}
+/**
+ * @struct FixedString
+ * @brief String literal usable as a template argument
+ * @tparam N Size of the literal, including the terminating null
+ */
+template <size_t N>
+struct FixedString {
+  constexpr FixedString(const char (&text)[N])
+  {
+    for (size_t i = 0; i < N; ++i) {
+      value[i] = text[i];
+    }
+  }
+
+  constexpr std::string_view view() const
+  {
+    return std::string_view(value, N - 1);
+  }
+
+  char value[N];
+};
+
+/**
+ * @struct Col
+ * @brief Compile-time description of a TypedTable column
+ * @tparam Name Header of the column
+ * @tparam T Type of the values in the column
+ * @tparam Width Width of the column content
+ * @tparam Alignment Horizontal alignment of the column
+ */
+template <FixedString Name, typename T, size_t Width, Align Alignment = Align::left>
+struct Col {
+  static_assert(Width > 0, "the width of a column must be positive");
+
+  using type = T;
+  static constexpr std::string_view name = Name.view();
+  static constexpr size_t width = Width;
+  static constexpr Align align = Alignment;
+};
+
+/**
+ * @class TypedTable
+ * @brief Table with a schema fixed at compile time
+ *
+ * Rows are appended as typed values, the header, widths and alignments come
+ * from the columns. Since the widths are known, appending a row only formats
+ * its own cells instead of measuring every column of the table again.
+ *
+ * @code
+ * TypedTable<Col<"PID", int, 8, Align::right>, Col<"User", std::string, 12>> processes;
+ * processes.add(1, "root");
+ * @endcode
+ *
+ * @tparam Cols The Col of every column, left to right
+ */
+template <typename... Cols>
+class TypedTable {
+ public:
+  /**
+   * @typedef row_type
+   * @brief Tuple holding the values of one row
+   */
+  using row_type = std::tuple<typename Cols::type...>;
+
+  /**
+   * @brief Number of columns
+   */
+  static constexpr size_t columns = sizeof...(Cols);
+
+  /**
+   * @brief Content width of every column
+   */
+  static constexpr std::array<size_t, sizeof...(Cols)> widths = {Cols::width...};
+
+  /**
+   * @brief Total content width of the columns, without borders and padding
+   */
+  static constexpr size_t content_width = (Cols::width + ... + 0);
+
+  /**
+   * @brief Constructor that adds the header row
+   */
+  TypedTable()
+  {
+    Row &header = table_.__add_row();
+    (header.add(std::string(Cols::name)), ...);
+    __on_add(header);
+  }
+
+  /**
+   * @brief Appends a row
+   * @param values One value per column
+   * @return Reference to the new row
+   */
+  Row &add(const typename Cols::type &...values)
+  {
+    Row &row = table_.__add_row();
+    (row.add(to_string<typename Cols::type>(values)), ...);
+    __on_add(row);
+
+    return row;
+  }
+
+  /**
+   * @brief Appends a row held in a tuple
+   * @param values One value per column
+   * @return Reference to the new row
+   */
+  Row &add(const row_type &values)
+  {
+    return std::apply([this](const typename Cols::type &...row) -> Row & { return add(row...); }, values);
+  }
+
+  /**
+   * @brief Gets a row by index, the header is row 0
+   * @param index The index of the row
+   * @return Reference to the row
+   */
+  Row &operator[](size_t index)
+  {
+    return *table_.rows[index];
+  }
+
+  /**
+   * @brief Gets the number of rows, including the header
+   * @return The row count
+   */
+  size_t size() const
+  {
+    return table_.rows.size();
+  }
+
+  /**
+   * @brief Gets the underlying table, to format or render it
+   * @return Reference to the table
+   */
+  Table &table()
+  {
+    return table_;
+  }
+
+  /**
+   * @brief Gets the underlying table, to render it
+   * @return Const reference to the table
+   */
+  const Table &table() const
+  {
+    return table_;
+  }
+
+  /**
+   * @brief Renders the table in xterm format
+   * @return String representation of the table
+   */
+  std::string xterm() const
+  {
+    return table_.xterm();
+  }
+
+  /**
+   * @brief Renders the table in Markdown format
+   * @return Markdown representation of the table
+   */
+  std::string markdown() const
+  {
+    return table_.markdown();
+  }
+
+  /**
+   * @brief Renders the table in LaTeX format
+   * @param indentation Number of spaces to indent content lines
+   * @return LaTeX representation of the table
+   */
+  std::string latex(size_t indentation = 0) const
+  {
+    return table_.latex(indentation);
+  }
+
+ private:
+  Table table_;
+
+  /**
+   * @brief Formats the cells of a new row with the widths and alignments of the columns
+   * @param row The new row
+   */
+  void __on_add(Row &row)
+  {
+    size_t index = 0;
+    ((row[index].format().width(Cols::width).align(Cols::align), table_.cells.push_back(row.cell(index)), ++index), ...);
+    table_.cached_width = content_width;
+  }
+};
 } // namespace tabulate
+#endif
+
+#if defined(TABULATE_HEADER_ONLY)
+#  include "tabulate.cc"
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file tabulate_fwd.h
+ * @brief Forward declarations of the tabulate types
+ *
+ * Include this header instead of tabulate.h where tables are only passed
+ * around by pointer or reference, it includes no standard header.
+ */
+
+/**
+ * Copyright 2022-2025 Kiran Nowak(kiran.nowak@gmail.com)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace tabulate
+{
+enum class Color;
+enum class ColorMode;
+enum class Which;
+enum class Style;
+enum class Exporter;
+
+struct TrueColor;
+class ColorMap;
+class Sparkline;
+struct Format;
+class BatchFormat;
+class Cell;
+class Row;
+class Column;
+class Table;
+template <typename... Cols>
+class TypedTable;
+
+struct RenderProfile;
+struct RenderStats;
+class RenderStatsScope;
+struct RenderJob;
+class ProgressUpdater;
+class Canvas;
+
+class Sink;
+class StringSink;
+class StreamSink;
+class FileSink;
+class AsyncSink;
+class GzipSink;
+class ZstdSink;
+class RowSource;
+class FunctionRowSource;
+template <typename Iterator, typename Sentinel>
+class RangeRowSource;
+} // namespace tabulate